@@ -0,0 +1,128 @@
+#ifndef Affine2D_hpp
+#define Affine2D_hpp
+
+#include "common.h"
+
+/*
+
+	2D affine transform, used for GameObject transforms instead of 4x4 matrices.
+
+	Same layout and conventions as SDL_gpu column-major matrix, minus unused elements:
+
+	| a  c  0  tx |
+	| b  d  0  ty |
+	| 0  0  1  z  |
+	| 0  0  0  1  |
+
+	Converted to 4x4 only when passed to SDL_gpu.
+
+*/
+
+struct Affine2D {
+
+	float a = 1, b = 0, c = 0, d = 1;
+	float tx = 0, ty = 0, z = 0;
+
+	/// resets to identity
+	inline void Identity() {
+		a = d = 1; b = c = tx = ty = z = 0;
+	}
+
+	/// sets to translate * rotate * scale * skew, same as GPU_MatrixTranslate, GPU_MatrixRotate, GPU_MatrixScale sequence
+	inline Affine2D& Compose( float x, float y, float zz, float angleDegrees, float scaleX, float scaleY, float skewX=0, float skewY=0 ) {
+		float cosA = 1, sinA = 0;
+		if ( angleDegrees != 0 ) {
+			float rad = angleDegrees * (float) M_PI / 180.0f;
+			cosA = cosf( rad ); sinA = sinf( rad );
+		}
+		a = cosA * scaleX; b = sinA * scaleX;
+		c = -sinA * scaleY; d = cosA * scaleY;
+		tx = x; ty = y; z = zz;
+		if ( skewX != 0 || skewY != 0 ) Skew( skewX, skewY );
+		return *this;
+	}
+
+	/// multiplies by skew matrix ( tan of angles in degrees ) on the right
+	inline void Skew( float skewX, float skewY ) {
+		float kx = tanf( skewX * DEG_TO_RAD ), ky = tanf( skewY * DEG_TO_RAD );
+		float na = a + c * ky, nb = b + d * ky;
+		c = a * kx + c; d = b * kx + d;
+		a = na; b = nb;
+	}
+
+	/// result = A * B ( result can't be A or B )
+	static inline void Multiply( Affine2D& result, const Affine2D& A, const Affine2D& B ) {
+		result.a = A.a * B.a + A.c * B.b;
+		result.b = A.b * B.a + A.d * B.b;
+		result.c = A.a * B.c + A.c * B.d;
+		result.d = A.b * B.c + A.d * B.d;
+		result.tx = A.a * B.tx + A.c * B.ty + A.tx;
+		result.ty = A.b * B.tx + A.d * B.ty + A.ty;
+		result.z = A.z + B.z;
+	}
+
+	/// writes inverse into dest, returns false ( and leaves dest unchanged ) if transform can't be inverted
+	inline bool Inverse( Affine2D& dest ) const {
+		float det = a * d - b * c;
+		if ( det == 0 ) return false;
+		det = 1.0f / det;
+		float ia = d * det, ib = -b * det, ic = -c * det, id = a * det;
+		dest.a = ia; dest.b = ib; dest.c = ic; dest.d = id;
+		dest.tx = -( ia * tx + ic * ty );
+		dest.ty = -( ib * tx + id * ty );
+		dest.z = -z;
+		return true;
+	}
+
+	/// extracts position, rotation in degrees and scale
+	inline void Decompose( b2Vec2& pos, float& angle, b2Vec2& scale ) const {
+		float sx = sqrtf( a * a + b * b );
+		float sy = sqrtf( c * c + d * d );
+		if ( a * d - b * c < 0 ) sx = -sx;
+		pos.x = tx;
+		pos.y = ty;
+		angle = -RAD_TO_DEG * atan2( c / sy, a / sx );
+		scale.x = sx;
+		scale.y = sy;
+	}
+
+	/// transforms point
+	inline void Apply( float x, float y, float& outX, float& outY ) const {
+		outX = a * x + c * y + tx;
+		outY = b * x + d * y + ty;
+	}
+
+	/// transforms direction ( ignores translation )
+	inline void ApplyDirection( float x, float y, float& outX, float& outY ) const {
+		outX = a * x + c * y;
+		outY = b * x + d * y;
+	}
+
+	/// writes as 4x4 column-major matrix
+	inline void ToMatrix( float* m ) const {
+		m[ 0 ] = a; m[ 1 ] = b; m[ 2 ] = 0; m[ 3 ] = 0;
+		m[ 4 ] = c; m[ 5 ] = d; m[ 6 ] = 0; m[ 7 ] = 0;
+		m[ 8 ] = 0; m[ 9 ] = 0; m[ 10 ] = 1; m[ 11 ] = 0;
+		m[ 12 ] = tx; m[ 13 ] = ty; m[ 14 ] = z; m[ 15 ] = 1;
+	}
+
+	/// reads 2D part of 4x4 column-major matrix
+	inline void FromMatrix( const float* m ) {
+		a = m[ 0 ]; b = m[ 1 ];
+		c = m[ 4 ]; d = m[ 5 ];
+		tx = m[ 12 ]; ty = m[ 13 ]; z = m[ 14 ];
+	}
+
+	/// multiplies 4x4 matrix m by this transform on the right, in place ( same as GPU_MultiplyAndAssign( m, this ) )
+	inline void MultiplyMatrix( float* m ) const {
+		for ( int r = 0; r < 4; r++ ) {
+			float m0 = m[ r ], m4 = m[ 4 + r ], m8 = m[ 8 + r ];
+			m[ r ] = m0 * a + m4 * b;
+			m[ 4 + r ] = m0 * c + m4 * d;
+			m[ 12 + r ] += m0 * tx + m4 * ty + m8 * z;
+		}
+	}
+
+};
+
+#endif /* Affine2D_hpp */
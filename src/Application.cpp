@@ -10,11 +10,16 @@
 
 // from ScriptableClass.hpp
 int ScriptableClass::asyncIndex = 0;
+uint32_t ScriptableClass::subscriptionsVersion = 1;
+uint32_t ScriptableClass::subscriptionsResetVersion = 1;
+uint32_t ScriptableClass::propertyHandlersVersion = 1;
 ScriptableClass::AsyncMap* ScriptableClass::scheduledAsyncs = NULL;
 ScriptableClass::DebouncerMap* ScriptableClass::scheduledDebouncers = NULL;
 
 // from Tween.hpp
-unordered_set<Tween*> *Tween::activeTweens = NULL;
+vector<Tween*> *Tween::activeTweens = NULL;
+unordered_map<void*, vector<Tween*>> *Tween::targetTweens = NULL;
+bool Tween::applyingValues = false;
 
 // from common.h
 size_t debugObjectsCreated = 0;
@@ -109,7 +114,8 @@ Application::Application() {
 	// init containers
 	ScriptableClass::scheduledAsyncs = new AsyncMap();
 	ScriptableClass::scheduledDebouncers = new DebouncerMap();
-	Tween::activeTweens = new unordered_set<Tween*>();
+	Tween::activeTweens = new vector<Tween*>();
+	Tween::targetTweens = new unordered_map<void*, vector<Tween*>>();
 	
     // register classes
 	this->InitClass();
@@ -138,6 +144,9 @@ Application::~Application() {
 	
 	printf( "(frames:%d, seconds:%f) average FPS: %f\n", this->frames, this->unscaledTime, ((float) this->frames / (float) this->unscaledTime) );
 	
+	// stop image loader threads
+	ImageLoader::Shutdown();
+	
 	// destroy window
 	GPU_Quit();
 	
@@ -151,6 +160,7 @@ Application::~Application() {
 	delete ScriptableClass::scheduledAsyncs;
 	delete ScriptableClass::scheduledDebouncers;	
 	delete Tween::activeTweens;
+	delete Tween::targetTweens;
 	
 	// stop terminal capture
 	tcsetattr( STDIN_FILENO, TCSANOW, &_savedTerminal );
@@ -196,7 +206,7 @@ void Application::SendResizedEvents() {
 	
 	// and send layout event to scene
 	if ( sceneStack.size() ) {
-		event.name = EVENT_LAYOUT;
+		event.SetId( EVENTID_LAYOUT );
 		event.stopped = false;
 		event.behaviorsOnly = true;
 		event.scriptParams.ResizeArguments( 0 );
@@ -206,6 +216,9 @@ void Application::SendResizedEvents() {
 
 void Application::UpdateBackscreen() {
 	
+	// redraw next frame
+	this->_renderForced = true;
+	
 	// actual size
 	int ww = this->windowWidth / this->windowScalingFactor,
 		hh = this->windowHeight / this->windowScalingFactor;
@@ -326,14 +339,14 @@ void Application::InitClass() {
 
 			// call removed event on current
 			if ( current ) {
-				event.name = EVENT_REMOVED;
+				event.SetId( EVENTID_REMOVED );
 				event.behaviorParam = current;
 				event.stopped = false;
 				current->CallEvent( event );
 			}
 			
 			// generate events
-			event.name = EVENT_SCENECHANGED;
+			event.SetId( EVENTID_SCENECHANGED );
 			event.stopped = false;
 			event.scriptParams.AddObjectArgument( newScene ? newScene->scriptObject : NULL );
 			event.scriptParams.AddObjectArgument( current ? current->scriptObject : NULL );
@@ -344,10 +357,10 @@ void Application::InitClass() {
 				event.stopped = false;
 				event.scriptParams.ResizeArguments( 0 );
 				event.behaviorParam = newScene;
-				event.name = EVENT_ADDED;
+				event.SetId( EVENTID_ADDED );
 				newScene->CallEvent( event );
 				
-				event.name = EVENT_LAYOUT;
+				event.SetId( EVENTID_LAYOUT );
 				event.stopped = false;
 				newScene->DispatchEvent( event );
 			}
@@ -414,6 +427,11 @@ void Application::InitClass() {
 		return v;
 	}));
 	
+	script.AddProperty<Application>
+	("skipIdleFrames",
+	 static_cast<ScriptBoolCallback>([](void* self, bool v){ return app.skipIdleFrames; }),
+	 static_cast<ScriptBoolCallback>([](void* self, bool v){ app._renderForced = true; return ( app.skipIdleFrames = v ); }));
+	
 	script.AddProperty<Application>
 	("fixedWindowResolution",
 	 static_cast<ScriptBoolCallback>([](void* self, bool v){ return app.fixedWindowResolution; }),
@@ -499,18 +517,18 @@ void Application::InitClass() {
 			Event event;
 			
 			if ( oldScene ) {
-				event.name = EVENT_REMOVED;
+				event.SetId( EVENTID_REMOVED );
 				event.behaviorParam = oldScene;
 				oldScene->CallEvent( event );
 			}
 			
 			event.stopped = false;
-			event.name = EVENT_ADDED;
+			event.SetId( EVENTID_ADDED );
 			event.behaviorParam = newScene;
 			newScene->CallEvent( event );
 			
 			event.stopped = false;
-			event.name = EVENT_SCENECHANGED;
+			event.SetId( EVENTID_SCENECHANGED );
 			event.scriptParams.AddObjectArgument( newScene ? newScene->scriptObject : NULL );
 			event.scriptParams.AddObjectArgument( oldScene ? oldScene->scriptObject : NULL );
 			app.CallEvent( event );
@@ -557,18 +575,18 @@ void Application::InitClass() {
 			Event event;
 			
 			if ( oldScene ) {
-				event.name = EVENT_REMOVED;
+				event.SetId( EVENTID_REMOVED );
 				event.behaviorParam = oldScene;
 				oldScene->CallEvent( event );
 			}
 			
 			event.stopped = false;
-			event.name = EVENT_ADDED;
+			event.SetId( EVENTID_ADDED );
 			event.behaviorParam = newScene;
 			newScene->CallEvent( event );
 			
 			event.stopped = false;
-			event.name = EVENT_SCENECHANGED;
+			event.SetId( EVENTID_SCENECHANGED );
 			event.scriptParams.AddObjectArgument( newScene ? newScene->scriptObject : NULL );
 			event.scriptParams.AddObjectArgument( oldScene ? oldScene->scriptObject : NULL );
 			app.CallEvent( event );
@@ -695,6 +713,54 @@ void Application::InitClass() {
 		return true;
 	}));
 	
+	script.DefineGlobalFunction
+	( "preload",
+	 static_cast<ScriptFunctionCallback>([](void*, ScriptArguments& sa ){
+		const char* error = "usage: preload( String textureName | Array textureNames [, Function callback( Boolean success ) ] )";
+		if ( !sa.args.size() || ( sa.args[ 0 ].type != TypeString && sa.args[ 0 ].type != TypeArray ) ||
+			( sa.args.size() > 1 && sa.args[ 1 ].type != TypeFunction ) ) {
+			script.ReportError( error );
+			return false;
+		}
+		
+		// start loading
+		ImageLoader::Batch batch;
+		ArgValueVector names;
+		if ( sa.args[ 0 ].type == TypeString ) names.push_back( sa.args[ 0 ] );
+		else names = *sa.args[ 0 ].value.arrayValue;
+		for ( size_t i = 0, nn = names.size(); i < nn; i++ ) {
+			if ( names[ i ].type != TypeString ) continue;
+			ImageResource* res = ImageLoader::Load( names[ i ].value.stringValue->c_str() );
+			res->AdjustUseCount( 1 ); // keep until batch completes
+			batch.resources.push_back( res );
+		}
+		
+		// callback is called from ImageLoader::ProcessLoaded
+		if ( sa.args.size() > 1 ) {
+			batch.callback.funcObject = sa.args[ 1 ].value.objectValue;
+			batch.callback.thisObject = script.global_object;
+		}
+		ImageLoader::batches.push_back( batch );
+		return true;
+	}));
+	
+	script.DefineGlobalFunction
+	( "textureLoaded",
+	 static_cast<ScriptFunctionCallback>([](void*, ScriptArguments& sa ){
+		string filename;
+		if ( !sa.ReadArguments( 1, TypeString, &filename ) ) {
+			script.ReportError( "usage: textureLoaded( String textureName )" );
+			return false;
+		}
+		
+		// only look up, don't load
+		string filepath, extension;
+		string key = ImageResource::ResolveKey( filename.c_str(), filepath, extension );
+		unordered_map<string, ImageResource*>::iterator it = app.textureManager.map.find( key );
+		sa.ReturnBool( it != app.textureManager.map.end() && it->second->error == ERROR_NONE && !it->second->IsLoading() );
+		return true;
+	}));
+	
 	script.DefineGlobalFunction
 	( "fileExists",
 	 static_cast<ScriptFunctionCallback>([](void*, ScriptArguments& sa ){
@@ -1261,16 +1327,30 @@ void Application::GarbageCollect() {
 	// call garbage collection in Spidermonkey
 	script.GC();
 	
-	// call clean up in each resource manager
-	textureManager.UnloadUnusedResources();
-	fontManager.UnloadUnusedResources();
-	scriptManager.UnloadUnusedResources();
-	soundManager.UnloadUnusedResources();
+	// clean up resource managers over next frames
+	this->_unloadPending = true;
 	
 	// done
 	// printf( "GC performed\n" );
 }
 
+/// runs scheduled collection and resource unloading, called after frame is presented
+void Application::ProcessGC() {
+	
+	// full collection when heap grows ( native classes don't implement barriers, so engine can't collect in slices )
+	if ( script.GCNeeded() ) this->GarbageCollect();
+	
+	// unload a few resources at a time
+	if ( this->_unloadPending ) {
+		int remaining = this->unloadsPerFrame;
+		this->_unloadPending = !(
+			textureManager.UnloadUnusedResources( remaining ) &&
+			fontManager.UnloadUnusedResources( remaining ) &&
+			scriptManager.UnloadUnusedResources( remaining ) &&
+			soundManager.UnloadUnusedResources( remaining ) );
+	}
+}
+
 void Application::TraceProtectedObjects( vector<void**> &protectedObjects ) {
 	// protect scenes stack
 	for ( size_t i = 0, ns = this->sceneStack.size(); i < ns; i++ ){
@@ -1326,11 +1406,17 @@ void Application::TraceProtectedObjects( vector<void**> &protectedObjects ) {
 		oit++;
 	}
 	
+	// protect preload callbacks
+	list<ImageLoader::Batch>::iterator bit = ImageLoader::batches.begin();
+	while( bit != ImageLoader::batches.end() ) {
+		if ( bit->callback.funcObject ) protectedObjects.push_back( &bit->callback.funcObject );
+		bit++;
+	}
+	
 	// protect running tweens
-	unordered_set<Tween*>::iterator tit = Tween::activeTweens->begin();
-	while( tit != Tween::activeTweens->end() ) {
-		if ( (*tit)->_active ) protectedObjects.push_back( &(*tit)->scriptObject );
-		tit++;
+	for ( size_t i = 0, nt = Tween::activeTweens->size(); i < nt; i++ ) {
+		Tween* t = (*Tween::activeTweens)[ i ];
+		if ( t->_active ) protectedObjects.push_back( &t->scriptObject );
 	}
 	
 	// protect playing sounds
@@ -1359,12 +1445,7 @@ void Application::GameLoop() {
 	Event event;
 	SDL_Event e;
 	Scene* scene = NULL;
-<<<<<<< HEAD
-    Uint32 benchmark = 1;
-    this->debugDraw = true;
-=======
     Uint32 benchmark = 0;
->>>>>>> parent of 5e63b91... wip optimisation
 
 	// stdin capture
 	char pollChar = 0;
@@ -1391,6 +1472,15 @@ void Application::GameLoop() {
 	// init backscreen
 	this->UpdateBackscreen();
 	
+	// compile common shader variants over first frames, instead of on first use
+	static const size_t warmUpShaders[] = {
+		SHADER_TEXTURE | SHADER_BATCH, SHADER_TEXTURE, SHADER_BASE,
+		SHADER_TEXTURE | SHADER_SLICE, SHADER_TEXTURE | SHADER_OUTLINE,
+		SHADER_PARTICLE, SHADER_PARTICLE | SHADER_TEXTURE,
+		SHADER_TEXTURE | SHADER_BLEND, SHADER_BLEND
+	};
+	RenderBehavior::WarmUpShaders( warmUpShaders, sizeof( warmUpShaders ) / sizeof( size_t ) );
+	
 	// initial resized and layout events
 	this->SendResizedEvents();
 	
@@ -1424,10 +1514,10 @@ void Application::GameLoop() {
 			scene->SimulatePhysics();
 
 			// update
-			event.name = EVENT_UPDATE;
+			event.SetId( EVENTID_UPDATE );
 			event.scriptParams.ResizeArguments( 0 );
 			event.scriptParams.AddFloatArgument( this->deltaTime );
-			scene->DispatchEvent( event, true );
+			scene->DispatchToSubscribers( event );
 			event.skipObject = NULL;
 			event.stopped = false; // reused
 		}
@@ -1439,7 +1529,7 @@ void Application::GameLoop() {
 		while( SDL_PollEvent( &e ) != 0 ){
 			
 			// let input handle events
-			if ( !benchmark ) input.HandleEvent( e );
+			if ( !benchmark || benchmark >= BENCHMARK_SCENE_UNBATCHED ) input.HandleEvent( e );
 			
 			// exit
 			if ( e.type == SDL_QUIT ) {
@@ -1454,19 +1544,14 @@ void Application::GameLoop() {
 				}
             
             // benchmark
-<<<<<<< HEAD
             } else if ( e.type == SDL_KEYDOWN ) {
                 if ( e.key.keysym.sym == SDLK_F2 ) {
-                    benchmark = (benchmark+1) % 8;
+                    benchmark = (benchmark+1) % BENCHMARK_NUM_MODES;
+                    RenderBehavior::batchSprites = ( benchmark != BENCHMARK_SCENE_UNBATCHED );
                     debugEventsDispatched.clear();
                 } else if ( e.key.keysym.sym == SDLK_F1 ){
                     this->debugDraw = !this->debugDraw;
                 }
-=======
-            } else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F1 ) {
-                benchmark = (benchmark+1) % 10;
-                debugEventsDispatched.clear();
->>>>>>> parent of 5e63b91... wip optimisation
             }
             
 
@@ -1474,17 +1559,36 @@ void Application::GameLoop() {
 			else if ( e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ) {
 				// adjust buffers
 				WindowResized( e.window.data1, e.window.data2 );
+			} else if ( e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_EXPOSED ) {
+				this->_renderForced = true;
 			}
 		}
 		
 		// capture console input (RPi workaround)
 		if ( poll( &pollStruct, 1, 0 ) == 1 ) read( STDIN_FILENO, &pollChar, 1 );
         
+		// upload images decoded in background, call preload callbacks
+		ImageLoader::ProcessLoaded();
+		
+		// compile queued shader variants
+		if ( RenderBehavior::shaderWarmUpQueue.size() ) RenderBehavior::ProcessShaderWarmUp( 8 );
+		
 		// perform asyncs & debounce calls
 		ScriptableClass::ProcessScheduledCalls( unscaledDeltaTime );
 		
 		// late events (scheduled by `fireLate` and `dispatchLate` / Application::AddLateEvent )
 		RunLateEvents();
+		
+		// nothing changed on screen - skip render and flip, wait instead of spinning
+		if ( !benchmark && !this->NeedsRender( scene ) ) {
+			this->ProcessGC();
+			Uint32 elapsed = SDL_GetTicks() - _time;
+			if ( elapsed < 16 ) SDL_Delay( 16 - elapsed );
+			continue;
+		}
+		this->_lastRenderFrame = this->frames;
+		this->_lastRenderScene = scene;
+		this->_renderForced = false;
         
         _rt = SDL_GetTicks();
 
@@ -1492,7 +1596,7 @@ void Application::GameLoop() {
 		GPU_ClearColor( this->screen, scene->backgroundColor->rgba );
         GPU_ResetProjection();
         
-        if ( benchmark ) {
+        if ( benchmark && benchmark < BENCHMARK_SCENE_UNBATCHED ) {
             
             static ImageResource* clown = app.textureManager.Get( "clown" );
             static ImageResource* poop = app.textureManager.Get( "poop" );
@@ -1502,50 +1606,35 @@ void Application::GameLoop() {
             float *p = GPU_GetProjection();
             GPU_MatrixIdentity( p );
             GPU_MatrixOrtho( p, 0, this->backScreen->target->w, this->backScreen->target->h, 0, -1024, 1024 );
+            GPU_DeactivateShaderProgram();
             
-<<<<<<< HEAD
+            // 1000 blits, same texture
             if ( benchmark == 1 ){
-=======
-            // 1000 blits
-            if ( benchmark == 2 ){
->>>>>>> parent of 5e63b91... wip optimisation
                 _t = SDL_GetTicks();
                 for ( int i = 0; i < 1000; i++ ) {
-                    GPU_Blit( clown->image, NULL, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
+                    GPU_Blit( clown->image, &clown->frame.locationOnTexture, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
                 }
-                debugEventsDispatched[ "1000 blits (no select shader)" ] = SDL_GetTicks() - _t;
-
+                debugEventsDispatched[ "1000 Blits" ] = SDL_GetTicks() - _t;
+                
+            // 1000 blits, flushed one at a time (same cost as switching shader per sprite)
             } else if ( benchmark == 2 ){
                 _t = SDL_GetTicks();
                 for ( int i = 0; i < 1000; i++ ) {
-                    // RenderBehavior::SelectBasicShader( clown->image );
-                    GPU_Blit( clown->image, NULL, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
+                    GPU_Blit( clown->image, &clown->frame.locationOnTexture, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
                     GPU_FlushBlitBuffer();
                 }
-<<<<<<< HEAD
-                debugEventsDispatched[ "1000 blits (select shader)" ] = SDL_GetTicks() - _t;
+                debugEventsDispatched[ "1000 Blits (flush each)" ] = SDL_GetTicks() - _t;
                 
+            // 1000 blits, alternating textures
             } else if ( benchmark == 3 ){
                 _t = SDL_GetTicks();
-=======
-                debugEventsDispatched[ "1000 Blits" ] = SDL_GetTicks() - _t;
-            // 1000 circles
-            } else if ( benchmark == 3 ){
-                _t = SDL_GetTicks();
-                static SDL_Color clr = { 0, 255, 0, 255 };
->>>>>>> parent of 5e63b91... wip optimisation
                 for ( int i = 0; i < 1000; i++ ) {
-                    GPU_Image* img = i % 2 ? clown->image : poop->image;
-                    RenderBehavior::SelectBasicShader( img );
-                    GPU_Blit( img, NULL, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
+                    ImageResource* res = i % 2 ? clown : poop;
+                    GPU_Blit( res->image, &res->frame.locationOnTexture, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
                 }
-<<<<<<< HEAD
                 debugEventsDispatched[ "1000 Blits alt tex" ] = SDL_GetTicks() - _t;
                 
-=======
-                debugEventsDispatched[ "1000 Circles" ] = SDL_GetTicks() - _t;
             // 1000 rectangles
->>>>>>> parent of 5e63b91... wip optimisation
             } else if ( benchmark == 4 ){
                 _t = SDL_GetTicks();
                 static SDL_Color clr = { 0, 0, 255, 255 };
@@ -1555,13 +1644,9 @@ void Application::GameLoop() {
                                         52 + 4 * (i % 100), 132 + i / 10, clr);
                     clr.r = (clr.r + 3) % 255;
                 }
-<<<<<<< HEAD
-                debugEventsDispatched[ "1000 Rects (no select shader)" ] = SDL_GetTicks() - _t;
-                
-=======
                 debugEventsDispatched[ "1000 Rects" ] = SDL_GetTicks() - _t;
-            // 1000 mixed
->>>>>>> parent of 5e63b91... wip optimisation
+                
+            // 1000 rectangles and blits, interleaved
             } else if ( benchmark == 5 ){
                 _t = SDL_GetTicks();
                 static SDL_Color clr = { 0, 128, 255, 255 };
@@ -1570,50 +1655,21 @@ void Application::GameLoop() {
                                         20 + 4 * (i % 100), 100 + i / 10,
                                         52 + 4 * (i % 100), 132 + i / 10, clr);
                     clr.r = (clr.r + 3) % 255;
-<<<<<<< HEAD
-                }
-                debugEventsDispatched[ "1000 Rects (select shader)" ] = SDL_GetTicks() - _t;
-                
-=======
                     GPU_Blit( clown->image, &clown->frame.locationOnTexture, this->backScreen->target, 20 + 4 * (i % 100), 100 + i / 10 );
                 }
                 debugEventsDispatched[ "1000 Rects+Blits" ] = SDL_GetTicks() - _t;
->>>>>>> parent of 5e63b91... wip optimisation
-            } else if ( benchmark == 6 ){
-                _t = SDL_GetTicks();
-                RenderBehavior::SelectBasicShader( clown->image );
-                static SDL_Color clr = { 128, 0, 255, 255 };
-                for ( int i = 0; i < 500; i++ ) {
-                    RenderBehavior::SelectBasicShader( clown->image );
-                    GPU_Blit( clown->image, NULL, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
-                    RenderBehavior::SelectBasicShader( NULL );
-                    GPU_RectangleFilled(this->backScreen->target,
-                                        20 + 4 * (i % 100), 100 + i / 10,
-                                        52 + 4 * (i % 100), 132 + i / 10, clr);
-                }
-                debugEventsDispatched[ "1000 Blits+rects" ] = SDL_GetTicks() - _t;
                 
-            } else if ( benchmark == 7 ){
+            // 1000 rectangles, then 1000 blits
+            } else if ( benchmark == 6 ){
                 _t = SDL_GetTicks();
                 static SDL_Color clr = { 0, 0, 255, 255 };
-<<<<<<< HEAD
-                RenderBehavior::SelectBasicShader( NULL );
-                for ( int i = 0; i < 500; i++ ) {
-=======
                 for ( int i = 0; i < 1000; i++ ) {
->>>>>>> parent of 5e63b91... wip optimisation
                     GPU_RectangleFilled(this->backScreen->target,
                                         20 + 4 * (i % 100), 100 + i / 10,
                                         52 + 4 * (i % 100), 132 + i / 10, clr);
                 }
-<<<<<<< HEAD
-                RenderBehavior::SelectBasicShader( clown->image );
-                for ( int i = 0; i < 500; i++ ) {
-                    GPU_Blit( clown->image, NULL, this->backScreen->target, 4 * (i % 100), 100 + i / 10 );
-=======
                 for ( int i = 0; i < 1000; i++ ) {
                     GPU_Blit( clown->image, &clown->frame.locationOnTexture, this->backScreen->target, 20 + 4 * (i % 100), 100 + i / 10 );
->>>>>>> parent of 5e63b91... wip optimisation
                 }
                 debugEventsDispatched[ "1000 Blits,rects" ] = SDL_GetTicks() - _t;
                 
@@ -1621,16 +1677,20 @@ void Application::GameLoop() {
                 
         } else {
             
-            // render scene graph
+            // render scene graph ( BENCHMARK_SCENE_UNBATCHED / BENCHMARK_SCENE_BATCHED time the same scene with sprite batching off / on )
             if ( scene ) {
+                _t = SDL_GetTicks();
                 // render to backscreen
-                event.name = EVENT_RENDER;
+                event.SetId( EVENTID_RENDER );
                 event.behaviorParam = this->backScreen->target;
                 event.behaviorParam2 = &this->blendTarget;
                 scene->Render( event );
+                RenderBehavior::FlushSpriteBatch();
                 event.behaviorParam = NULL;
                 event.skipObject = NULL;
                 event.stopped = false; // reused
+                if ( benchmark == BENCHMARK_SCENE_UNBATCHED ) debugEventsDispatched[ "Scene (unbatched)" ] = SDL_GetTicks() - _t;
+                else if ( benchmark == BENCHMARK_SCENE_BATCHED ) debugEventsDispatched[ "Scene (batched)" ] = SDL_GetTicks() - _t;
             }
         }
         
@@ -1645,6 +1705,9 @@ void Application::GameLoop() {
             debugEventsDispatched[ "DebugDraw" ] = SDL_GetTicks() - _t;
         }
         GPU_Flip( this->screen );
+		
+		// use time after present for collection
+		this->ProcessGC();
 
 	}
 	
@@ -1657,6 +1720,16 @@ void Application::GameLoop() {
 	// exit requested
 }
 
+/// returns true if frame needs to be rendered
+bool Application::NeedsRender( Scene* scene ) {
+	
+	// always render
+	if ( !this->skipIdleFrames || this->_renderForced || this->debugDraw || scene != this->_lastRenderScene ) return true;
+	
+	// something changed since ( or during ) last render
+	return ( this->renderChangedFrame >= this->_lastRenderFrame );
+}
+
 /* MARK:    -                Debug draw
  -------------------------------------------------------------------- */
 
@@ -1704,9 +1777,9 @@ ArgValueVector* Application::AddLateEvent( ScriptableClass* obj, const char* eve
 	LateEvent* event = NULL;
 	
 	// find existing for this object
-	string ename( eventName );
+	EventId eventId = Event::IdForName( eventName );
 	ObjectEventMap& eventMap = lateEvents[ obj ];
-	ObjectEventMap::iterator it = eventMap.find( ename );
+	ObjectEventMap::iterator it = eventMap.find( eventId );
 	
 	// found existing, return it
 	if ( it != eventMap.end() ) {
@@ -1714,7 +1787,7 @@ ArgValueVector* Application::AddLateEvent( ScriptableClass* obj, const char* eve
 		event->lateDispatch = dispatch;
 	} else {
 		// otherwise emplace new
-		auto p = eventMap.emplace( ename, dispatch );
+		auto p = eventMap.emplace( eventId, dispatch );
 		event = &(p.first->second);
 	}
 	
@@ -1747,7 +1820,8 @@ void Application::RunLateEvents( int maxRepeats ) {
 		while ( it != end ) {
 			if ( obj->scriptObject ) {
 				LateEvent& le = it->second;
-				Event event( it->first.c_str() );
+				Event event;
+				event.SetId( it->first );
 				event.bubbles = le.bubbles;
 				event.behaviorsOnly = le.behaviorsOnly;
 				// add params
@@ -1795,14 +1869,8 @@ string ResolvePath( const char* filepath, const char* ext, const char* optionalS
 			// find script
 			ScriptResource* sr = app.scriptManager.Get( shortPath.c_str() );
 			if ( sr->error ) {
-				unordered_map<string, ScriptResource*>::iterator it = app.scriptManager.map.begin();
-				while ( it != app.scriptManager.map.end() ) {
-					if ( it->second->path.compare( scriptPath ) == 0 ) {
-						sr = it->second;
-						break;
-					}
-					it++;
-				}
+				ScriptResource* byPath = app.scriptManager.FindByPath( scriptPath.c_str() );
+				if ( byPath ) sr = byPath;
 			}
 			if ( !sr->error ) {
 				// remove filename from current script
@@ -2050,6 +2118,16 @@ string GetScriptNameAndLine() {
 	return "";
 }
 
+/// returns filename of script currently executing, or NULL
+const char* GetCallingScriptFilename() {
+	unsigned lineNumber = 0;
+	JSScript* curScript = NULL;
+	if ( JS_DescribeScriptedCaller( script.js, &curScript, &lineNumber ) ) {
+		return JS_GetScriptFilename( script.js, curScript );
+	}
+	return NULL;
+}
+
 /// quick and simple hashing function
 size_t HashString( const char* p ) {
 	size_t result = 0;
@@ -2060,25 +2138,6 @@ size_t HashString( const char* p ) {
 	return result;
 }
 
-/// compose matrix helper
-float* MatrixCompose( float* mat, float x, float y, float angleDegrees, float scaleX, float scaleY ) {
-	GPU_MatrixIdentity( mat );
-	GPU_MatrixTranslate( mat, x, y, 0 );
-	if ( angleDegrees != 0 ) GPU_MatrixRotate( mat, angleDegrees, 0, 0, 1 );
-	if ( scaleX != 0 || scaleY != 0 ) GPU_MatrixScale( mat, scaleX, scaleY, 1 );
-	return mat;
-}
-
-void MatrixSkew( float* result, float sx, float sy ) {
-	if(result == NULL) return;
-	float A[16];
-	A[0] = 1; A[1] = tan(sy * DEG_TO_RAD); A[2] = 0; A[3] = 0;
-	A[4] = tan(sx * DEG_TO_RAD); A[5] = 1; A[6] = 0; A[7] = 0;
-	A[8] = 0; A[9] = 0; A[10] = 1; A[11] = 0;
-	A[12] = 0; A[13] = 0; A[14] = 0; A[15] = 1;
-	GPU_MultiplyAndAssign(result, A);
-}
-
 string HexStr( Uint32 w, size_t hex_len ) {
 	static const char* digits = "0123456789ABCDEF";
 	string rc( hex_len, '0' );
@@ -19,6 +19,11 @@
 #include <termios.h>
 #include <poll.h>
 
+// F2 benchmark modes ( 1 - 6 are raw SDL_gpu draws )
+#define BENCHMARK_SCENE_UNBATCHED	7
+#define BENCHMARK_SCENE_BATCHED		8
+#define BENCHMARK_NUM_MODES			9
+
 // Main application controller
 class Application : public ScriptableClass {
 public:
@@ -123,8 +128,17 @@ public:
 	/// stores compiled scripts
 	ResourceManager<SoundResource> soundManager;
 	
-	/// unloads unused resources and calls garbage collector in script 
+	/// calls garbage collector in script, and schedules unloading of unused resources
 	void GarbageCollect();
+	
+	/// max number of resources unloaded per frame after GarbageCollect
+	int unloadsPerFrame = 4;
+	
+	/// true while unused resources are being unloaded over several frames
+	bool _unloadPending = false;
+	
+	/// runs scheduled collection and resource unloading, called after frame is presented
+	void ProcessGC();
 
 // event queue
 	
@@ -136,7 +150,7 @@ public:
 		ArgValueVector params;
 		LateEvent( bool disp ) : lateDispatch( disp ) {};
 	};
-	typedef unordered_map<string,LateEvent> ObjectEventMap;
+	typedef unordered_map<EventId,LateEvent> ObjectEventMap;
 	typedef unordered_map<ScriptableClass*, ObjectEventMap> LateEventMap;
 	
 	LateEventMap lateEvents;
@@ -174,6 +188,22 @@ public:
 	/// total frames rendered
 	int frames = 0;
 	
+	/// frame when anything affecting rendered image last changed ( see GameObject::RenderChanged )
+	int renderChangedFrame = 0;
+	
+	/// if true, frames where nothing changed are not rendered or flipped
+	bool skipIdleFrames = false;
+	
+	/// set to render next frame even if nothing changed ( resize, expose )
+	bool _renderForced = true;
+	
+	/// frame and scene last rendered
+	int _lastRenderFrame = 0;
+	Scene* _lastRenderScene = NULL;
+	
+	/// returns true if frame needs to be rendered
+	bool NeedsRender( Scene* scene );
+	
 	/// current frames per second
 	float fps = 0;
 	
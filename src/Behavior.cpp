@@ -140,10 +140,12 @@ bool Behavior::SetGameObject( GameObject* newGameObject ){
 
 			// clear
 			this->gameObject = NULL;
+			oldGameObject->EventHandlersChanged( EVENTID_NONE );
 			
 			// call detached event directly on event
-			BehaviorEventCallback func = this->GetCallbackForEvent( EVENT_DETACHED );
+			BehaviorEventCallback func = this->GetCallbackForEvent( EVENTID_DETACHED );
 			if ( func ) func( this, oldGameObject, &event );
+			oldGameObject->InvalidateBounds();
 			
 		}
 		
@@ -154,10 +156,12 @@ bool Behavior::SetGameObject( GameObject* newGameObject ){
 		if ( newGameObject ) {
 			
 			newGameObject->behaviors.push_back( this );
+			newGameObject->EventHandlersChanged( EVENTID_NONE );
 			
 			// call attached event directly on event
-			BehaviorEventCallback func = this->GetCallbackForEvent( EVENT_ATTACHED );
+			BehaviorEventCallback func = this->GetCallbackForEvent( EVENTID_ATTACHED );
 			if ( func ) func( this, gameObject, &event );
+			newGameObject->InvalidateBounds();
 			
 		}
 		
@@ -174,7 +178,7 @@ bool Behavior::SetGameObject( GameObject* newGameObject ){
 void Behavior::CallEventCallback( Event &event ) {
 
 	// find function
-	BehaviorEventCallback func = this->GetCallbackForEvent( event.name );
+	BehaviorEventCallback func = this->GetCallbackForEvent( event.id );
 	
 	// if callback for this event exists, call it
 	if ( func != NULL ) (*func)( this, event.behaviorParam, &event );
@@ -183,7 +187,7 @@ void Behavior::CallEventCallback( Event &event ) {
 
 void Behavior::AddEventCallback( const char* eventName, BehaviorEventCallback callback ) {
 	
-	eventFunctions[ eventName ] = callback;
+	eventFunctions[ Event::IdForName( eventName ) ] = callback;
 	
 }
 
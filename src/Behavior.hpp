@@ -22,9 +22,9 @@ class GameObject;
 /// Behavior callback method type via a static class function
 typedef void (*BehaviorEventCallback) ( void* behavior, void* param, Event* event );
 
-/// maps hash(char*) -> BehaviorEventCallback
-typedef unordered_map<string, BehaviorEventCallback> BehaviorEventMap;
-typedef unordered_map<string, BehaviorEventCallback>::iterator BehaviorEventIterator;
+/// maps event id -> BehaviorEventCallback
+typedef unordered_map<EventId, BehaviorEventCallback> BehaviorEventMap;
+typedef unordered_map<EventId, BehaviorEventCallback>::iterator BehaviorEventIterator;
 
 class Behavior : public ScriptableClass {
 public:
@@ -68,7 +68,7 @@ public:
 	void CallEventCallback( Event& event );
 	
 	/// returns callback, or NULL
-	inline BehaviorEventCallback GetCallbackForEvent( const char* eventName ) { BehaviorEventIterator it = eventFunctions.find( eventName ); return it == eventFunctions.end() ? NULL : it->second; }
+	inline BehaviorEventCallback GetCallbackForEvent( EventId eventId ) { BehaviorEventIterator it = eventFunctions.find( eventId ); return it == eventFunctions.end() ? NULL : it->second; }
 	
 // active
 	
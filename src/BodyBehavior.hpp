@@ -40,8 +40,14 @@ public:
 	
 	virtual void EnableBody( bool e ){};
 	
-	/// called after physics step on each body to sync position and rotation
-	virtual void SyncObjectToBody(){};
+	/// called after physics step on each body to sync position and rotation, alpha < 1 interpolates from previous step
+	virtual void SyncObjectToBody( float alpha=1 ){};
+	
+	/// stores current body transform as previous step's, for interpolation
+	virtual void SavePreviousTransform(){};
+	
+	/// makes sure body is synced after next physics step
+	virtual void MarkActive(){};
 	
 	/// call to sync body to manually set object position
 	virtual void SyncBodyToObject(){};
@@ -662,6 +662,32 @@ void Color::Notify() {
 	
 }
 
+void Color::Replace( Color*& slot, Color* other ) {
+	
+	if ( !other || other == slot ) return;
+	
+	// other belongs to another owner - copy, so both keep their callbacks
+	if ( other->callback ) {
+		slot->rgba = other->rgba;
+		slot->r = other->r;
+		slot->g = other->g;
+		slot->b = other->b;
+		slot->a = other->a;
+		slot->_hsvDirty = true;
+		slot->Notify();
+		return;
+	}
+	
+	// move owner's callback to new color
+	if ( slot->callback ) {
+		other->callback = slot->callback;
+		slot->callback = NULL;
+	}
+	slot = other;
+	other->Notify();
+	
+}
+
 
 
 
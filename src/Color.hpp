@@ -57,6 +57,9 @@ public:
 	ColorCallback callback = NULL;
 	void Notify();
 	
+	/// assigns other to an owner's color slot, moving owner's change callback to it, so in-place changes keep notifying. If other already has an owner, its value is copied instead
+	static void Replace( Color*& slot, Color* other );
+	
 	// scripting
 	
 	static void InitClass();
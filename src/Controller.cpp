@@ -419,7 +419,7 @@ void Controller::DispatchActions( int key, SDL_Event& e, vector<Binding>& action
 		int state = this->states[ b.action ];
 		int onState = ( b.type == BUTTON ? 1 : ( b.type == DIR_NEGATIVE ? -1 : 1 ) );
 		int newState = 0;
-		event.name = b.action.c_str();
+		event.SetName( b.action.c_str() );
 		event.scriptParams.ResizeArguments( 0 );
 		
 		// joystick axis
@@ -541,7 +541,7 @@ void Controller::DispatchActions( int key, SDL_Event& e, vector<Binding>& action
 			event.scriptParams.AddObjectArgument( this->scriptObject );
 			
 			// dispatch as navigation event
-			event.name = EVENT_NAVIGATION;
+			event.SetId( EVENTID_NAVIGATION );
 			app.input.UIEvent( event );
 			
 		}
@@ -87,6 +87,8 @@ string FontResource::ResolveKey(const char *ckey, string &fullpath, string &exte
 FontResource::~FontResource (){
 
 	// clean up
+	this->glyphs.clear();
+	for ( size_t i = 0, np = this->glyphPages.size(); i < np; i++ ) delete this->glyphPages[ i ];
 	if ( this->font ) TTF_CloseFont( this->font );
 	
 }
@@ -96,3 +98,85 @@ bool FontResource::LoadFromMemory(void *p, int s) {
     this->font = TTF_OpenFontRW( rwops, 1, this->size );
     return (this->font != NULL);
 }
+
+/* MARK:	-				Glyphs
+ -------------------------------------------------------------------- */
+
+
+/// returns prerendered glyph, rendering it on first use
+GlyphInfo* FontResource::GetGlyph( Uint16 c, int style, int outline, bool antialias ) {
+	
+	// try to find it first
+	Uint64 key = (Uint64) c | ( (Uint64) style << 16 ) | ( (Uint64) antialias << 24 ) | ( (Uint64) outline << 32 );
+	unordered_map<Uint64, GlyphInfo>::iterator it = this->glyphs.find( key );
+	if ( it != this->glyphs.end() ) return &it->second;
+	
+	// create in place
+	GlyphInfo* gi = &this->glyphs[ key ];
+	
+	// non-printable
+	TTF_SetFontStyle( this->font, style );
+	TTF_SetFontOutline( this->font, 0 );
+	if ( c < 32 || TTF_GlyphMetrics( this->font, c, &gi->minX, &gi->maxX, &gi->minY, &gi->maxY, &gi->advance ) != 0 ) return gi;
+	
+	// ensure min advance
+	gi->maxX += outline * 2;
+	gi->maxY += outline * 2;
+	gi->advance = fmax( gi->advance, gi->maxX - gi->minX );
+	
+	// draw
+	TTF_SetFontOutline( this->font, outline );
+	TTF_SetFontHinting( this->font, TTF_HINTING_NORMAL );
+	static SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* ss = NULL;
+	if ( antialias ) {
+		ss = TTF_RenderGlyph_Blended( this->font, c, white );
+	} else {
+		ss = TTF_RenderGlyph_Solid( this->font, c, white );
+	}
+	if ( !ss ) return gi;
+	
+	// find space on existing page
+	GPU_Rect paddedRect;
+	int pw = ss->w + ATLAS_PADDING * 2, ph = ss->h + ATLAS_PADDING * 2;
+	TextureAtlasPage* page = NULL;
+	for ( size_t i = 0, np = this->glyphPages.size(); i < np && !page; i++ ) {
+		if ( this->glyphPages[ i ]->Allocate( pw, ph, paddedRect ) ) page = this->glyphPages[ i ];
+	}
+	
+	// add page
+	if ( !page && pw <= ATLAS_PAGE_SIZE && ph <= ATLAS_PAGE_SIZE ) {
+		page = new TextureAtlasPage();
+		if ( page->image && page->Allocate( pw, ph, paddedRect ) ) {
+			GPU_SetBlendFunction( page->image, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE_MINUS_SRC_ALPHA, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE );
+			GPU_SetBlendEquation( page->image, GPU_EQ_ADD, GPU_EQ_ADD );
+			this->glyphPages.push_back( page );
+		} else {
+			delete page;
+			page = NULL;
+		}
+	}
+	
+	// copy to page
+	if ( page ) {
+		page->Copy( ss, paddedRect );
+		page->numFrames++;
+		gi->surface = page->image;
+		gi->rect = { paddedRect.x + ATLAS_PADDING, paddedRect.y + ATLAS_PADDING, (float) ss->w, (float) ss->h };
+	// too large, own texture
+	} else {
+		gi->surface = GPU_CopyImageFromSurface( ss );
+		gi->ownsSurface = true;
+		gi->rect = { 0, 0, (float) ss->w, (float) ss->h };
+		gi->surface->anchor_x = gi->surface->anchor_y = 0;
+		GPU_UnsetImageVirtualResolution( gi->surface );
+		GPU_SetImageFilter( gi->surface, GPU_FILTER_NEAREST );
+		GPU_SetSnapMode( gi->surface, GPU_SNAP_NONE );
+		GPU_SetBlendFunction( gi->surface, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE_MINUS_SRC_ALPHA, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE );
+		GPU_SetBlendEquation( gi->surface, GPU_EQ_ADD, GPU_EQ_ADD);
+	}
+	SDL_FreeSurface( ss );
+	
+	// done
+	return gi;
+}
@@ -2,10 +2,26 @@
 #define FontResource_hpp
 
 #include "ResourceManager.hpp"
+#include "ImageResource.hpp"
+
+/// a prerendered single glyph
+struct GlyphInfo {
+	GPU_Image* surface = NULL; // shared atlas page, or own image if glyph is too large
+	GPU_Rect rect = { 0, 0, 0, 0 }; // location on surface
+	bool ownsSurface = false;
+	int minX = 0;
+	int minY = 0;
+	int maxX = 0;
+	int maxY = 0;
+	int advance = 0;
+	GlyphInfo(){};
+	~GlyphInfo(){ if ( this->surface && this->ownsSurface ) { GPU_FreeTarget( this->surface->target ); GPU_FreeImage( this->surface ); } };
+};
 
 /* MARK:	-				Font resource
  
  Loads a TTF font. Key must be in the form "FONTNAME,ptSize"
+ Rendered glyphs are shared by all texts using this font, packed on atlas pages.
  -------------------------------------------------------------------- */
 
 class FontResource : public Resource {
@@ -14,6 +30,15 @@ public:
 	TTF_Font* font = NULL;
 	int size = 16;
 	
+	/// prerendered glyphs, keyed by character, style, outline, and antialias
+	unordered_map<Uint64, GlyphInfo> glyphs;
+	
+	/// textures glyphs are packed on
+	vector<TextureAtlasPage*> glyphPages;
+	
+	/// returns prerendered glyph, rendering it on first use
+	GlyphInfo* GetGlyph( Uint16 c, int style, int outline, bool antialias );
+	
 	static string ResolveKey( const char* ckey, string& fullpath, string& extension );
 	
     bool LoadFromMemory( void* p, int size );
@@ -2,6 +2,7 @@
 #include "Scene.hpp"
 #include "Application.hpp"
 #include "Tween.hpp"
+#include "Image.hpp"
 
 
 /* MARK:	-				Init / destroy
@@ -45,6 +46,9 @@ GameObject::~GameObject() {
 	
 	// release resource
 	if ( this->scriptResource ) this->scriptResource->AdjustUseCount( -1 );
+	
+	// release render cache
+	if ( this->_cacheImage ) delete this->_cacheImage;
     
 }
 
@@ -90,7 +94,18 @@ void GameObject::InitClass() {
 	( "ignoreCamera",
 	 static_cast<ScriptBoolCallback>([](void* go, bool a ) { return ((GameObject*) go)->ignoreCamera; }),
 	 static_cast<ScriptBoolCallback>([](void* go, bool a ) {
-		return (((GameObject*) go)->ignoreCamera = a );
+		GameObject* self = (GameObject*) go;
+		if ( self->ignoreCamera != a ) self->InvalidateBounds();
+		return ( self->ignoreCamera = a );
+	}));
+
+	script.AddProperty<GameObject>
+	( "culling",
+	 static_cast<ScriptBoolCallback>([](void* go, bool a ) { return ((GameObject*) go)->culling; }),
+	 static_cast<ScriptBoolCallback>([](void* go, bool a ) {
+		GameObject* self = (GameObject*) go;
+		if ( self->culling != a ) self->InvalidateBounds();
+		return ( self->culling = a );
 	}));
 	
 	script.AddProperty<GameObject>
@@ -210,10 +225,27 @@ void GameObject::InitClass() {
 		return go->opacity;
 	}));
 
+	script.AddProperty<GameObject>
+	( "cached",
+	 static_cast<ScriptBoolCallback>([](void* go, bool a ) { return ((GameObject*) go)->cached; }),
+	 static_cast<ScriptBoolCallback>([](void* go, bool a ) {
+		GameObject* self = (GameObject*) go;
+		// release cache when turned off
+		if ( !a && self->_cacheImage ) {
+			delete self->_cacheImage;
+			self->_cacheImage = NULL;
+		}
+		return ( self->cached = a );
+	}));
+	
 	script.AddProperty<GameObject>
 	( "renderAfterChildren",
 	 static_cast<ScriptBoolCallback>([](void *b, bool val ){ return ((GameObject*) b)->renderAfterChildren; }),
-	 static_cast<ScriptBoolCallback>([](void *b, bool val ){ return ( ((GameObject*) b)->renderAfterChildren = val ); }) );
+	 static_cast<ScriptBoolCallback>([](void *b, bool val ){
+		GameObject* self = (GameObject*) b;
+		if ( self->renderAfterChildren != val ) self->RenderChanged();
+		return ( self->renderAfterChildren = val );
+	}) );
 	
 	script.AddProperty<GameObject>
 	( "eventMask",
@@ -1124,20 +1156,11 @@ void GameObject::InitClass() {
 void GameObject::DispatchEvent( Event& event, bool callOnSelf, GameObjectCallback *forEachGameObject ) {
 	
 	// event mask
-	if ( this->eventMask ) {
-		vector<string>* emask = this->eventMask->ToStringVector();
-		size_t numEventMask = emask->size();
-		if ( numEventMask > 0 ) {
-			for ( size_t i = 0; i < numEventMask; i++ ) {
-				// masked, ignore
-				if ( (*emask)[ i ].compare( event.name ) == 0 ) return;
-			}
-		}
-	}
+	if ( this->MasksEvent( event ) ) return;
 	
 	// clippable UI events
 	bool clearClipped = false;
-	if ( event.name == EVENT_MOUSEDOWN || event.name == EVENT_MOUSEMOVE || event.name == EVENT_MOUSEUP ) {
+	if ( event.id == EVENTID_MOUSEDOWN || event.id == EVENTID_MOUSEMOVE || event.id == EVENTID_MOUSEUP ) {
 	    // parent clips this object
 		if ( this->parent && this->parent->render != NULL && this->parent->render->ClipsMouseEventsFor( this ) ) {
 			clearClipped = true;
@@ -1217,6 +1240,32 @@ void GameObject::CallEvent( Event &event ) {
 	
 }
 
+/// true if event is in this object's eventMask
+bool GameObject::MasksEvent( Event& event ) {
+	if ( !this->eventMask ) return false;
+	vector<string>* emask = this->eventMask->ToStringVector();
+	for ( size_t i = 0, numEventMask = emask->size(); i < numEventMask; i++ ) {
+		if ( (*emask)[ i ].compare( event.name ) == 0 ) return true;
+	}
+	return false;
+}
+
+/// true if a behavior, script listener, or property function on this object handles event
+bool GameObject::SubscribesToEvent( EventId eventId ) {
+	// behaviors
+	for( BehaviorList::iterator i = this->behaviors.begin(), e = this->behaviors.end(); i != e; i++ ){
+		if ( (*i)->GetCallbackForEvent( eventId ) != NULL ) return true;
+	}
+	// script, property function lookup is cached
+	return this->HasListenersForEvent( eventId );
+}
+
+/// stamps this object and its ancestors, so subscriber lists of scene or overlay containing it are rebuilt
+void GameObject::SubscriptionsChanged() {
+	uint32_t version = ++subscriptionsVersion;
+	for ( GameObject* obj = this; obj != NULL; obj = obj->parent ) obj->_subscriptionsVersion = version;
+}
+
 /// returns ArgValueVector with each behavior's scriptObject
 ArgValueVector* GameObject::GetBehaviorsVector() {
 	ArgValueVector* vec = new ArgValueVector();
@@ -1299,8 +1348,10 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 		GameObject* oldParent = this->parent;
 		if ( oldParent ) {
 			
-			// parent's z-order should be updated
+			// parent's z-order, bounds and event subscribers should be updated
 			oldParent->zSortedChildren.clear();
+			oldParent->InvalidateBounds();
+			oldParent->SubscriptionsChanged();
 			
 			// find this object in parent's list of children
 			GameObjectVector *parentList = &oldParent->children;
@@ -1319,7 +1370,7 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 			
 			// call event on this object only
 			Event event( this->scriptObject );
-			event.name = EVENT_REMOVED;
+			event.SetId( EVENTID_REMOVED );
 			event.behaviorParam = oldParent;
 			event.scriptParams.AddObjectArgument( oldParent->scriptObject );
 			event.scriptParams.AddIntArgument( removedAt );
@@ -1328,15 +1379,16 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 			// call child removed
 			event.stopped = false;
 			event.scriptParams.ResizeArguments( 0 );
-			event.name = EVENT_CHILDREMOVED;
+			event.SetId( EVENTID_CHILDREMOVED );
 			event.behaviorParam = this;
 			event.scriptParams.AddObjectArgument( this->scriptObject );
 			event.scriptParams.AddIntArgument( removedAt );
 			oldParent->CallEvent( event );
 		}
 		
-		// set parent
+		// set parent ( generation of new parent is unrelated, recalculate world transform )
 		this->parent = newParent;
+		this->DirtyTransform();
 		
 		// callback for orphaning
 		GameObjectCallback makeOrphan = [](GameObject *obj) { obj->orphan = true; return true; };
@@ -1363,12 +1415,14 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 				desiredPosition = (int) newParent->children.size();
 			}
 			
-			// parent's z-order should be updated
+			// parent's z-order, bounds and event subscribers should be updated
 			newParent->zSortedChildren.clear();
+			newParent->InvalidateBounds();
+			newParent->SubscriptionsChanged();
 			
 			// call event on this object only
 			Event event( this->scriptObject );
-			event.name = EVENT_ADDED;
+			event.SetId( EVENTID_ADDED );
 			event.behaviorParam = newParent;
 			event.scriptParams.AddObjectArgument( newParent->scriptObject );
 			event.scriptParams.AddIntArgument( desiredPosition );
@@ -1385,14 +1439,14 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 				if ( newParent->orphan ) {
 					
 					// means this object has been removed from scene, dispatch event and make it orphan
-					event.name = EVENT_REMOVEDFROMSCENE;
+					event.SetId( EVENTID_REMOVEDFROMSCENE );
 					this->DispatchEvent( event, true, &makeOrphan );
 					
 				} else {
 					
 					// means this object has been added to scene, dispatch event and set orphan values on descendants
 					GameObjectCallback moveToScene = [](GameObject *obj) { obj->orphan = false; return true; };
-					event.name = EVENT_ADDEDTOSCENE;
+					event.SetId( EVENTID_ADDEDTOSCENE );
 					this->DispatchEvent( event, true, &moveToScene );
 					
 				}
@@ -1401,7 +1455,7 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 			// call child added
 			event.stopped = false;
 			event.scriptParams.ResizeArguments( 0 );
-			event.name = EVENT_CHILDADDED;
+			event.SetId( EVENTID_CHILDADDED );
 			event.behaviorParam = this;
 			event.scriptParams.AddObjectArgument( this->scriptObject );
 			event.scriptParams.AddIntArgument( desiredPosition );
@@ -1412,7 +1466,7 @@ void GameObject::SetParent( GameObject* newParent, int desiredPosition ) {
 			
 			// means this object has been removed from scene, dispatch event and make it orphan
 			Event event( this->scriptObject );
-			event.name = EVENT_REMOVEDFROMSCENE;
+			event.SetId( EVENTID_REMOVEDFROMSCENE );
 			event.behaviorParam = this;
 			this->DispatchEvent( event, true, &makeOrphan );
 			
@@ -1561,43 +1615,36 @@ bool GameObject::UseBodyTransform(){
 }
 
 // returns current transformation matrix, also updates local coords, if body+dirty
-float* GameObject::Transform() {
+Affine2D& GameObject::Transform() {
 	
 	if( isnan(this->_position.x) || isnan(this->_position.y) ) {
 		_position.Set(0, 0);
 	}
 
 	// body + local coords arent up to date, or parent's transform
-	if ( this->UseBodyTransform() && ( this->_localCoordsAreDirty || ( this->parent && this->parent->_inverseWorldDirty ) ) ) {
+	if ( this->UseBodyTransform() && ( this->_localCoordsAreDirty || this->ParentWorldChanged() ) ) {
 		
 		// get global coords from body
 		b2Vec2 pos; float angle;
 		this->body->GetBodyTransform( pos, angle );
-		GPU_MatrixIdentity( this->_worldTransform );
-		GPU_MatrixTranslate( this->_worldTransform, floor( pos.x ), floor( pos.y ), _z );
-		if ( angle != 0 ) GPU_MatrixRotate( this->_worldTransform, angle * RAD_TO_DEG, 0, 0, 1 );
-		if ( this->_scale.x != 1 || this->_scale.y != 1 ) GPU_MatrixScale( this->_worldTransform, this->_scale.x, this->_scale.y, 1 );
-		this->_worldTransformDirty = false;
+		this->_worldTransform.Compose( floor( pos.x ), floor( pos.y ), _z, angle * RAD_TO_DEG, this->_scale.x, this->_scale.y );
+		this->WorldTransformUpdated();
 		
 		// multiply by parent's inverse world to get local
-		if ( this->parent ) GPU_MatrixMultiply( this->_transform, this->parent->InverseWorld(), this->_worldTransform );
+		if ( this->parent ) Affine2D::Multiply( this->_transform, this->parent->InverseWorld(), this->_worldTransform );
 		
 		// decompose local into components
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
 		
 		// add skew
-		if ( this->_skew.x != 0 || this->_skew.y != 0 ) MatrixSkew( this->_transform, _skew.x, _skew.y );
+		if ( this->_skew.x != 0 || this->_skew.y != 0 ) this->_transform.Skew( _skew.x, _skew.y );
 		
 		this->_localCoordsAreDirty = false;
 		
 	} else if ( this->_transformDirty ) {
 		
 		// apply local transform
-		GPU_MatrixIdentity( this->_transform );
-		GPU_MatrixTranslate( this->_transform, floor( this->_position.x ), floor( this->_position.y ), _z );
-		if ( this->_angle != 0 ) GPU_MatrixRotate( this->_transform, this->_angle, 0, 0, 1 );
-		if ( this->_scale.x != 1 || this->_scale.y != 1 ) GPU_MatrixScale( this->_transform, this->_scale.x, this->_scale.y, 1 );
-		if ( this->_skew.x != 0 || this->_skew.y != 0 ) MatrixSkew( this->_transform, _skew.x, _skew.y );
+		this->_transform.Compose( floor( this->_position.x ), floor( this->_position.y ), _z, this->_angle, this->_scale.x, this->_scale.y, _skew.x, _skew.y );
 	}
 	
 	// clear flag
@@ -1617,6 +1664,7 @@ void GameObject::SetTransform( float x, float y, float angle, float scaleX, floa
 	this->_scale.Set( scaleX, scaleY );
 	this->_angle = angle;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	this->_localCoordsAreDirty = false;
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
@@ -1625,6 +1673,7 @@ void GameObject::SetPosition( float x, float y ) {
 	//this->Transform();
 	this->_position.Set( x, y );
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1633,6 +1682,7 @@ void GameObject::SetPositionAndAngle( float x, float y, float angle ) {
 	this->_position.Set( x, y );
 	this->_angle = angle;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1640,6 +1690,7 @@ void GameObject::SetX( float x ) {
 	//this->Transform();
 	this->_position.x = x;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1647,12 +1698,14 @@ void GameObject::SetY( float y ) {
 	//this->Transform();
 	this->_position.y = y;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
 void GameObject::SetZ( float z ) {
 	this->_z = z;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->parent ) this->parent->zSortedChildren.clear();
 }
 
@@ -1660,6 +1713,7 @@ void GameObject::SetAngle( float a ) {
 	//this->Transform();
 	this->_angle = a;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1667,6 +1721,7 @@ void GameObject::SetSkewX( float sx ) {
 	//this->Transform();
 	this->_skew.x = sx;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1674,6 +1729,7 @@ void GameObject::SetSkewY( float sy ) {
 	//this->Transform();
 	this->_skew.y = sy;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1681,6 +1737,7 @@ void GameObject::SetScale( float sx, float sy ) {
 	//this->Transform();
 	this->_scale.Set( sx, sy );
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1688,6 +1745,7 @@ void GameObject::SetScaleX( float sx ) {
 	//this->Transform();
 	this->_scale.x = sx;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1695,6 +1753,7 @@ void GameObject::SetScaleY( float sy ) {
 	//this->Transform();
 	this->_scale.y = sy;
 	this->_transformDirty = this->_inverseWorldDirty = this->_worldTransformDirty = true;
+	if ( this->parent ) this->parent->InvalidateBounds();
 	if ( this->UseBodyTransform() ) this->body->SyncBodyToObject();
 }
 
@@ -1750,12 +1809,14 @@ void GameObject::SetWorldTransform( float x, float y, float angle, float scaleX,
 		this->body->SyncObjectToBody();
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, x, y, angle, scaleX, scaleY ) );
+						this->_worldTransform.Compose( x, y, 0, angle, scaleX, scaleY ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1771,12 +1832,14 @@ void GameObject::SetWorldPosition( float x, float y ) {
 		b2Vec2 wpos, wscale; float wangle;
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
 		// local transform = parent's inverse world * this world matrix
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, x, y, wangle, wscale.x, wscale.y ) );
+						this->_worldTransform.Compose( x, y, 0, wangle, wscale.x, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1792,12 +1855,14 @@ void GameObject::SetWorldPositionAndAngle( float x, float y, float angle ) {
 		b2Vec2 wpos, wscale; float wangle;
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
 		// local transform = parent's inverse world * this world matrix
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, x, y, angle, wscale.x, wscale.y ) );
+						this->_worldTransform.Compose( x, y, 0, angle, wscale.x, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1814,12 +1879,14 @@ void GameObject::SetWorldX( float x ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, x, wpos.y, wangle, wscale.x, wscale.y ) );
+						this->_worldTransform.Compose( x, wpos.y, 0, wangle, wscale.x, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1836,12 +1903,14 @@ void GameObject::SetWorldY( float y ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, wpos.x, y, wangle, wscale.x, wscale.y ) );
+						this->_worldTransform.Compose( wpos.x, y, 0, wangle, wscale.x, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1857,12 +1926,14 @@ void GameObject::SetWorldAngle( float angle ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, wpos.x, wpos.y, angle, wscale.x, wscale.y ) );
+						this->_worldTransform.Compose( wpos.x, wpos.y, 0, angle, wscale.x, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1878,12 +1949,14 @@ void GameObject::SetWorldScale( float sx, float sy ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, wpos.x, wpos.y, wangle, sx, sy ) );
+						this->_worldTransform.Compose( wpos.x, wpos.y, 0, wangle, sx, sy ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1899,12 +1972,14 @@ void GameObject::SetWorldScaleX( float sx ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, wpos.x, wpos.y, wangle, sx, wscale.y ) );
+						this->_worldTransform.Compose( wpos.x, wpos.y, 0, wangle, sx, wscale.y ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1920,12 +1995,14 @@ void GameObject::SetWorldScaleY( float sy ) {
 	} else if ( this->parent ) {
 		// local transform = parent's inverse world * this world matrix
 		this->DecomposeTransform( this->WorldTransform(), wpos, wangle, wscale );
-		GPU_MatrixMultiply( this->_transform,
+		Affine2D::Multiply( this->_transform,
 						this->parent->InverseWorld(),
-						MatrixCompose( this->_worldTransform, wpos.x, wpos.y, wangle, wscale.x, sy ) );
+						this->_worldTransform.Compose( wpos.x, wpos.y, 0, wangle, wscale.x, sy ) );
 		// extract pos, rot, scale back into variables
 		this->DecomposeTransform( this->_transform, this->_position, this->_angle, this->_scale );
-		this->_transformDirty = false; this->_inverseWorldDirty = true;
+		this->_transformDirty = false;
+		this->WorldTransformUpdated();
+		this->parent->InvalidateBounds();
 	}
 }
 
@@ -1985,7 +2062,10 @@ float GameObject::GetWorldAngle() {
 }
 
 /// returns world transform of this object
-float* GameObject::WorldTransform() {
+Affine2D& GameObject::WorldTransform() {
+	
+	// ancestor moved since last time ( body transform doesn't depend on parent )
+	if ( !this->_worldTransformDirty && !this->UseBodyTransform() && this->ParentWorldChanged() ) this->_worldTransformDirty = true;
 	
 	if ( this->_worldTransformDirty ) {
 		
@@ -1996,31 +2076,48 @@ float* GameObject::WorldTransform() {
 		if ( this->parent != NULL ) {
 			
 			// concat world transform
-			GPU_MatrixMultiply( this->_worldTransform, this->parent->WorldTransform(), this->_transform );
+			Affine2D::Multiply( this->_worldTransform, this->parent->WorldTransform(), this->_transform );
 			
 		// no parent
 		} else {
 			
 			//local transform is world
-			GPU_MatrixCopy( this->_worldTransform, this->_transform );
+			this->_worldTransform = this->_transform;
 			
 		}
 		// dirty flags
-		this->_worldTransformDirty = false;
-		this->_inverseWorldDirty = true;
+		this->WorldTransformUpdated();
 		
 	}
 	
 	return this->_worldTransform;
 }
 
+/// true if parent's world transform changed since this object's transform was calculated
+bool GameObject::ParentWorldChanged() {
+	if ( !this->parent ) return false;
+	this->parent->WorldTransform();
+	return ( this->parent->_worldGeneration != this->_parentWorldGeneration );
+}
+
+/// call after writing _worldTransform, clears dirty flag and advances generation
+void GameObject::WorldTransformUpdated() {
+	this->_worldTransformDirty = false;
+	this->_inverseWorldDirty = true;
+	this->_worldGeneration++;
+	if ( this->parent ) this->_parentWorldGeneration = this->parent->_worldGeneration;
+}
+
 /// returns inverse of local transform of this object
-float* GameObject::InverseWorld() {
+Affine2D& GameObject::InverseWorld() {
+	
+	// make sure world transform is current
+	this->WorldTransform();
 	
 	if ( this->_inverseWorldDirty ) {
 		
 		// invert world matrix
-		GameObject::MatrixInverse( this->WorldTransform(), this->_inverseWorldTransform );
+		this->WorldTransform().Inverse( this->_inverseWorldTransform );
 		
 		// dirty flags
 		this->_inverseWorldDirty = false;
@@ -2031,59 +2128,8 @@ float* GameObject::InverseWorld() {
 }
 
 /// extracts local x, y, angle, and scale from local transform matrix
-void GameObject::DecomposeTransform( float *te, b2Vec2& pos, float& angle, b2Vec2& scale ) {
-	
-	float sx = b2Vec3( te[ 0 ], te[ 1 ], te[ 2 ] ).Length();
-	float sy = b2Vec3( te[ 4 ], te[ 5 ], te[ 6 ] ).Length();
-	
-	float n11 = te[ 0 ], n12 = te[ 4 ], n13 = te[ 8 ], n14 = te[ 12 ];
-	float n21 = te[ 1 ], n22 = te[ 5 ], n23 = te[ 9 ], n24 = te[ 13 ];
-	float n31 = te[ 2 ], n32 = te[ 6 ], n33 = te[ 10 ], n34 = te[ 14 ];
-	float n41 = te[ 3 ], n42 = te[ 7 ], n43 = te[ 11 ], n44 = te[ 15 ];
-	
-	float det = ( n41 * (
-						 + n14 * n23 * n32
-						 - n13 * n24 * n32
-						 - n14 * n22 * n33
-						 + n12 * n24 * n33
-						 + n13 * n22 * n34
-						 - n12 * n23 * n34
-						 ) + n42 * (
-									+ n11 * n23 * n34
-									- n11 * n24 * n33
-									+ n14 * n21 * n33
-									- n13 * n21 * n34
-									+ n13 * n24 * n31
-									- n14 * n23 * n31
-									) + n43 * (
-											   + n11 * n24 * n32
-											   - n11 * n22 * n34
-											   - n14 * n21 * n32
-											   + n12 * n21 * n34
-											   + n14 * n22 * n31
-											   - n12 * n24 * n31
-											   ) + n44 * (
-														  - n13 * n22 * n31
-														  - n11 * n23 * n32
-														  + n11 * n22 * n33
-														  + n13 * n21 * n32
-														  - n12 * n21 * n33
-														  + n12 * n23 * n31
-														  ) );
-	
-	if ( det < 0 ) sx = - sx;
-	
-	// extract position
-	pos.x = te[ 12 ];
-	pos.y = te[ 13 ];
-	
-	// extract rotation
-	angle = -RAD_TO_DEG * atan2( te[ 4 ] / sy, te[ 0 ] / sx );
-	
-	// scale
-	scale.x = sx;
-	scale.y = sy;
-	
+void GameObject::DecomposeTransform( Affine2D& te, b2Vec2& pos, float& angle, b2Vec2& scale ) {
+	te.Decompose( pos, angle, scale );
 }
 
 // setter for active
@@ -2094,6 +2140,7 @@ bool GameObject::active( bool a ) {
 		
 		// apply
 		this->_active = a;
+		this->RenderChanged();
 		
 		// dispatch to self and children
 		Event event( EVENT_ACTIVECHANGED, this->scriptObject );
@@ -2242,55 +2289,50 @@ bool GameObject::IsCameraIgnored() {
 // converts between coord systems
 void GameObject::ConvertPoint( float x, float y, float &outX, float &outY, bool localToGlobal, bool screenSpace ) {
 	
-	// matrix with x, y
-	float mat[ 16 ];
-	float res[ 16 ];
-	GPU_MatrixIdentity( mat );
-	GPU_MatrixTranslate( mat, x, y, 0 );
+	float rx = x, ry = y;
 	
 	// multiply by inverse world
 	Scene* scene = orphan ? NULL : GetScene();
 	if ( localToGlobal ) {
 		this->_worldTransformDirty = true;
-		GPU_MatrixMultiply( res, this->WorldTransform(), mat );
+		this->WorldTransform().Apply( x, y, rx, ry );
 		// apply camera transform
 		if ( screenSpace && scene && !this->IsCameraIgnored() ) {
-			GPU_MatrixCopy( mat, res );
-			GPU_MatrixMultiply( res, scene->CameraTransform(), mat );
+			float* cam = scene->CameraTransform();
+			float cx = rx, cy = ry;
+			rx = cam[ 0 ] * cx + cam[ 4 ] * cy + cam[ 12 ];
+			ry = cam[ 1 ] * cx + cam[ 5 ] * cy + cam[ 13 ];
 		}
 	// multiply by world
 	} else {
 		// apply inverse camera
 		if ( screenSpace && scene && !this->IsCameraIgnored() ) {
-			GPU_MatrixMultiply( res, scene->InverseCameraTransform(), mat );
-			GPU_MatrixCopy( mat, res );
+			float* icam = scene->InverseCameraTransform();
+			rx = icam[ 0 ] * x + icam[ 4 ] * y + icam[ 12 ];
+			ry = icam[ 1 ] * x + icam[ 5 ] * y + icam[ 13 ];
 		}
-		GPU_MatrixMultiply( res, this->InverseWorld(), mat );
+		this->InverseWorld().Apply( rx, ry, rx, ry );
 
 	}
-	outX = isnan(res[ 12 ]) ? 0 : res[ 12 ];
-	outY = isnan(res[ 13 ]) ? 0 : res[ 13 ];
+	outX = isnan( rx ) ? 0 : rx;
+	outY = isnan( ry ) ? 0 : ry;
 }
 
 void GameObject::ConvertDirection( float x, float y, float &outX, float &outY, bool localToGlobal ) {
-    float* m;
     float len = sqrtf( x * x + y * y );
     if ( len == 0.0 ) {
         outX = outY = 0;
         return;
     }
     
-    // multiply by inverse world
+    // multiply by world
     if ( localToGlobal ) {
         this->_worldTransformDirty = true;
-        m = this->WorldTransform();
-    // multiply by world
+        this->WorldTransform().ApplyDirection( x, y, outX, outY );
+    // multiply by inverse world
     } else {
-       m = this->InverseWorld();
+        this->InverseWorld().ApplyDirection( x, y, outX, outY );
     }
-
-    outX = m[ 0 ] * x + m[ 4 ] * y;
-    outY = m[ 1 ] * x + m[ 5 ] * y;
 }
 
 GPU_Rect GameObject::GetBounds(){
@@ -2300,15 +2342,111 @@ GPU_Rect GameObject::GetBounds(){
 	return r;
 }
 
+// marks subtree bounds of this object and its parents for recalculation
+void GameObject::InvalidateBounds() {
+	GameObject* obj = this;
+	// if already dirty, parents are dirty too
+	while ( obj && !obj->_subtreeBoundsDirty ) {
+		obj->_subtreeBoundsDirty = true;
+		obj = obj->parent;
+	}
+	// anything changing bounds changes render
+	this->RenderChanged();
+}
+
+// stamps this object and its parents as changed this frame
+void GameObject::RenderChanged( bool ownContent ) {
+	app.renderChangedFrame = app.frames;
+	if ( ownContent ) this->_contentChangedFrame = app.frames;
+	GameObject* obj = this;
+	// if already stamped this frame, parents are stamped too ( parent's content includes this object )
+	while ( obj && obj->_renderChangedFrame != app.frames ) {
+		obj->_renderChangedFrame = app.frames;
+		obj = obj->parent;
+		if ( obj ) obj->_contentChangedFrame = app.frames;
+	}
+}
+
+// any native property ( position, opacity, etc. ) set from script
+void GameObject::NativePropertyChanged() {
+	this->RenderChanged( false );
+}
+
+// expands rect to include rect r transformed by matrix m ( or untransformed, if m is NULL )
+static void _ExpandBounds( GPU_Rect& bounds, const GPU_Rect& r, const Affine2D* m ) {
+	if ( r.w < 0 || r.h < 0 ) return;
+	float cx[ 4 ] = { r.x, r.x + r.w, r.x + r.w, r.x };
+	float cy[ 4 ] = { r.y, r.y, r.y + r.h, r.y + r.h };
+	float minX = bounds.x, minY = bounds.y, maxX = bounds.x + bounds.w, maxY = bounds.y + bounds.h;
+	bool empty = ( bounds.w < 0 || bounds.h < 0 );
+	for ( int i = 0; i < 4; i++ ) {
+		float x = cx[ i ], y = cy[ i ];
+		if ( m ) m->Apply( cx[ i ], cy[ i ], x, y );
+		if ( empty ) { minX = maxX = x; minY = maxY = y; empty = false; }
+		else {
+			minX = fmin( minX, x ); minY = fmin( minY, y );
+			maxX = fmax( maxX, x ); maxY = fmax( maxY, y );
+		}
+	}
+	bounds = { minX, minY, maxX - minX, maxY - minY };
+}
+
+// returns true if local rect r, transformed by matrix mvp into clip space, is completely outside of view
+static bool _IsRectOutsideView( const GPU_Rect& r, float* mvp ) {
+	if ( r.w < 0 || r.h < 0 ) return true;
+	float cx[ 4 ] = { r.x, r.x + r.w, r.x + r.w, r.x };
+	float cy[ 4 ] = { r.y, r.y, r.y + r.h, r.y + r.h };
+	int left = 0, right = 0, top = 0, bottom = 0;
+	for ( int i = 0; i < 4; i++ ) {
+		float w = mvp[ 3 ] * cx[ i ] + mvp[ 7 ] * cy[ i ] + mvp[ 15 ];
+		if ( w <= 0 ) return false;
+		float x = ( mvp[ 0 ] * cx[ i ] + mvp[ 4 ] * cy[ i ] + mvp[ 12 ] ) / w;
+		float y = ( mvp[ 1 ] * cx[ i ] + mvp[ 5 ] * cy[ i ] + mvp[ 13 ] ) / w;
+		if ( x < -1 ) left++; else if ( x > 1 ) right++;
+		if ( y < -1 ) bottom++; else if ( y > 1 ) top++;
+	}
+	return ( left == 4 || right == 4 || top == 4 || bottom == 4 );
+}
+
+// recalculates local-space bounds of this object's render and all descendants, returns false if they can't be determined
+bool GameObject::UpdateSubtreeBounds() {
+	
+	// cached
+	if ( !this->_subtreeBoundsDirty ) return this->_subtreeBounded;
+	this->_subtreeBoundsDirty = false;
+	
+	// start empty
+	GPU_Rect bounds = { 0, 0, -1, -1 };
+	bool bounded = this->culling;
+	
+	// own render
+	if ( this->render ) {
+		GPU_Rect rb;
+		if ( this->render->GetCullBounds( rb ) ) _ExpandBounds( bounds, rb, NULL );
+		else bounded = false;
+	}
+	
+	// children ( all are updated, to keep their cache valid )
+	for ( size_t i = 0, nc = this->children.size(); i < nc; i++ ) {
+		GameObject* child = this->children[ i ];
+		if ( !child->UpdateSubtreeBounds() ) bounded = false;
+		// physics driven, or drawn without camera - position relative to this object is unknown
+		if ( child->UseBodyTransform() || child->ignoreCamera ) bounded = false;
+		if ( bounded ) _ExpandBounds( bounds, child->_subtreeBounds, &child->Transform() );
+	}
+	
+	this->_subtreeBounds = bounds;
+	return ( this->_subtreeBounded = bounded );
+}
+
 // force recalculate matrices on this object + all descendants
 void GameObject::DirtyTransform() {
 	
-	// set dirty
+	// set dirty, descendants see it through _worldGeneration when this object's world transform is recalculated
 	this->_transformDirty = this->_inverseWorldDirty = this->_localCoordsAreDirty = this->_worldTransformDirty = true;
-	// recurse
-	for ( size_t i = 0, nc = this->children.size(); i < nc; i++ ){
-		this->children[ i ]->DirtyTransform();
-	}
+	if ( this->parent ) this->parent->InvalidateBounds();
+	if ( this->body ) this->body->MarkActive();
+	this->RenderChanged( false );
 	
 }
 
@@ -2319,6 +2457,9 @@ bool _zSortChildrenCompare( GameObject* a, GameObject* b ) {
 	return a->GetZ() < b->GetZ();
 }
 
+/// true while any subtree is being rendered into its cache
+static bool _renderingAnyCache = false;
+
 // Renders this GameObject using renderer behavior, goes recursive
 void GameObject::Render( Event& event ) {
 	
@@ -2329,8 +2470,8 @@ void GameObject::Render( Event& event ) {
 		event.clippedBy = this->parent->render;
 	}
 	
-	// if ignoring camera, load identity
-    if ( this->ignoreCamera ) {
+	// if ignoring camera, load identity ( cache render sets its own view, also used by descendants )
+    if ( this->ignoreCamera && !_renderingAnyCache ) {
         // push view matrix
         GPU_MatrixMode( GPU_PROJECTION );
         GPU_PushMatrix();
@@ -2343,44 +2484,66 @@ void GameObject::Render( Event& event ) {
 	// push parent transform matrix
 	GPU_MatrixMode( GPU_MODELVIEW );
 	GPU_PushMatrix();
-<<<<<<< HEAD
-    float* mv = GPU_GetCurrentMatrix();
-=======
 	GPU_FlushBlitBuffer(); // without this, child transform affects parent
->>>>>>> parent of 5e63b91... wip optimisation
+	float* mv = GPU_GetCurrentMatrix();
 	
-	// update combined opacity
-	this->combinedOpacity = ( this->parent ? this->parent->combinedOpacity : 1 ) * this->opacity;
+	// update combined opacity ( cache is drawn opaque, and faded when drawn )
+	this->combinedOpacity = this->_renderingCache ? 1 : ( ( this->parent ? this->parent->combinedOpacity : 1 ) * this->opacity );
+	
+	// rendering into own cache, view maps world coordinates into cache
+	if ( this->_renderingCache ) {
+		
+		this->WorldTransform().ToMatrix( mv );
 	
 	// transforming using body
-	if ( this->UseBodyTransform() ) {
+	} else if ( this->UseBodyTransform() ) {
 		
 		// if rendering to image / clipped
 		if ( event.clippedBy ) {
 			// container's world transform
-			GPU_MatrixCopy( mv, event.clippedBy->gameObject->InverseWorld() );
-			GPU_MultMatrix( this->_worldTransform );
+			event.clippedBy->gameObject->InverseWorld().ToMatrix( mv );
+			this->_worldTransform.MultiplyMatrix( mv );
 		} else {
-			GPU_MatrixCopy( mv, this->_worldTransform );
+			this->_worldTransform.ToMatrix( mv );
 		}
 		
 	} else {
 		
-		// multiply
-		GPU_MultMatrix( this->Transform() );
-		
-		// update world matrix
-		GPU_MatrixCopy( this->_worldTransform, mv );
-		this->_worldTransformDirty = false;
-		this->_inverseWorldDirty = true;
+		// multiply ( blit buffer was flushed above )
+		this->Transform().MultiplyMatrix( mv );
+		
+		// update world matrix, descendants only need to recalculate theirs if it changed
+		Affine2D renderedWorld;
+		renderedWorld.FromMatrix( mv );
+		if ( this->_worldTransformDirty || memcmp( &renderedWorld, &this->_worldTransform, sizeof( Affine2D ) ) != 0 ) {
+			this->_worldTransform = renderedWorld;
+			this->WorldTransformUpdated();
+		} else if ( this->parent ) {
+			this->_parentWorldGeneration = this->parent->_worldGeneration;
+		}
 		
 	}
 	
-	// render before children?
+	// cull this object and children, if outside of view
+	bool visible = true;
 	bool doRender = (this->render != NULL && this->render->active());
+	if ( this->culling && !app.debugDraw ) {
+		float mvp[ 16 ];
+		GPU_MatrixMultiply( mvp, GPU_GetProjection(), mv );
+		if ( this->UpdateSubtreeBounds() ) visible = !_IsRectOutsideView( this->_subtreeBounds, mvp );
+		// own render
+		GPU_Rect rb;
+		if ( visible && doRender && this->render->GetCullBounds( rb ) ) doRender = !_IsRectOutsideView( rb, mvp );
+	}
+	if ( !visible ) doRender = false;
+	
+	// draw subtree from cache instead
+	if ( visible && this->cached && !this->_renderingCache && this->RenderCached( event ) ) visible = doRender = false;
+	
+	// render before children?
 	if ( doRender && !this->renderAfterChildren ) {
 		// find function
-		BehaviorEventCallback func = this->render->GetCallbackForEvent( event.name );
+		BehaviorEventCallback func = this->render->GetCallbackForEvent( event.id );
 		if ( func != NULL ) (*func)( this->render, event.behaviorParam, &event );
 	}
 	
@@ -2388,8 +2551,8 @@ void GameObject::Render( Event& event ) {
 	if ( this->ui && app.debugDraw ) ui->DebugDraw( (GPU_Target*) event.behaviorParam );
 	
 	// sort children
-	int numChildren = (int) this->children.size();
-	if ( zSortedChildren.size() != numChildren ) {
+	int numChildren = visible ? (int) this->children.size() : 0;
+	if ( visible && zSortedChildren.size() != numChildren ) {
 		zSortedChildren = children;
 		if ( numChildren > 1 ) sort( zSortedChildren.begin(), zSortedChildren.end(), &_zSortChildrenCompare );
 	}
@@ -2407,14 +2570,14 @@ void GameObject::Render( Event& event ) {
 	// render after children?
 	if ( doRender && this->renderAfterChildren ) {
 		// find function
-		BehaviorEventCallback func = this->render->GetCallbackForEvent( event.name );
+		BehaviorEventCallback func = this->render->GetCallbackForEvent( event.id );
 		if ( func != NULL ) (*func)( this->render, event.behaviorParam, &event );
 	}
 	
 	// pop matrices
 	GPU_MatrixMode( GPU_MODELVIEW );
 	GPU_PopMatrix();
-    if ( this->ignoreCamera ) {
+    if ( this->ignoreCamera && !_renderingAnyCache ) {
         GPU_MatrixMode( GPU_PROJECTION );
         GPU_PopMatrix();
     }
@@ -2423,3 +2586,53 @@ void GameObject::Render( Event& event ) {
 	if ( clearClipped ) event.clippedBy = NULL;
 
 }
+
+/// draws subtree from _cacheImage, re-rendering it once subtree has stopped changing. Returns false if subtree should be rendered live.
+bool GameObject::RenderCached( Event& event ) {
+	
+	// need known, reasonably sized bounds
+	if ( !this->UpdateSubtreeBounds() ) return false;
+	GPU_Rect rect;
+	rect.x = floor( this->_subtreeBounds.x );
+	rect.y = floor( this->_subtreeBounds.y );
+	rect.w = ceil( this->_subtreeBounds.x + this->_subtreeBounds.w ) - rect.x;
+	rect.h = ceil( this->_subtreeBounds.y + this->_subtreeBounds.h ) - rect.y;
+	if ( rect.w <= 0 || rect.h <= 0 || rect.w > 4096 || rect.h > 4096 ) return false;
+	
+	// contents changed since cache was drawn ( moving the object itself doesn't invalidate it )
+	if ( !this->_cacheImage || this->_contentChangedFrame >= this->_cacheFrame ) {
+		
+		// still changing - render live until it settles
+		if ( this->_cacheImage && app.frames - this->_contentChangedFrame <= 1 ) return false;
+		
+		// world to cache
+		Affine2D view;
+		if ( !this->WorldTransform().Inverse( view ) ) return false;
+		
+		// render subtree into image ( autoDraw makes Draw clear it first )
+		float opacity = this->combinedOpacity;
+		RenderBehavior::FlushSpriteBatch();
+		if ( !this->_cacheImage ) this->_cacheImage = new Image();
+		this->_cacheImage->width = rect.w;
+		this->_cacheImage->height = rect.h;
+		this->_cacheImage->autoDraw = this;
+		bool wasRenderingCache = _renderingAnyCache;
+		this->_renderingCache = _renderingAnyCache = true;
+		this->_cacheImage->Draw( this, false, -rect.x, -rect.y, 0, 1, 1, &view );
+		this->_renderingCache = false;
+		_renderingAnyCache = wasRenderingCache;
+		this->combinedOpacity = opacity;
+		this->_cacheFrame = app.frames;
+		this->_cacheRect = rect;
+		if ( !this->_cacheImage->image ) return false;
+	}
+	
+	// draw as single quad
+	GPU_Image* image = this->_cacheImage->image;
+	RenderBehavior::FlushSpriteBatch();
+	GPU_DeactivateShaderProgram();
+	GPU_SetBlendMode( image, GPU_BLEND_NORMAL );
+	image->color = { 255, 255, 255, (Uint8) ( 255 * this->combinedOpacity ) };
+	GPU_BlitRect( image, NULL, (GPU_Target*) event.behaviorParam, &this->_cacheRect );
+	return true;
+}
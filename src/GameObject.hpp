@@ -9,9 +9,12 @@
 #include "RigidBodyBehavior.hpp"
 #include "ParticleGroupBehavior.hpp"
 #include "TypedVector.hpp"
+#include "Affine2D.hpp"
 
 typedef vector<GameObject*> GameObjectVector;
 
+class Image;
+
 typedef list<Behavior*> BehaviorList;
 
 SCRIPT_CLASS_NAME( GameObject, "GameObject" );
@@ -26,13 +29,13 @@ protected:
 	bool _active = true;
 	
 	/// local transformation matrix
-	float _transform[16];
+	Affine2D _transform;
 	
 	/// combined transformation matrix
-	float _worldTransform[16];
+	Affine2D _worldTransform;
 	
 	/// inverse world transformation matrix
-	float _inverseWorldTransform[16];
+	Affine2D _inverseWorldTransform;
 	
 	/// x, y coordinates
 	b2Vec2 _position = { 0, 0 };
@@ -61,6 +64,18 @@ protected:
 	/// true when inverse world transform matrix needs to be recalculated
 	bool _inverseWorldDirty = true;
 	
+	/// incremented each time world transform changes, so descendants can detect their world transform is stale without being visited
+	uint32 _worldGeneration = 1;
+	
+	/// parent's _worldGeneration when this object's world transform ( or local coords, if using body transform ) was last calculated
+	uint32 _parentWorldGeneration = 0;
+	
+	/// true if parent's world transform changed since this object's transform was calculated
+	bool ParentWorldChanged();
+	
+	/// call after writing _worldTransform, clears dirty flag and advances generation
+	void WorldTransformUpdated();
+	
 public:
 	
 	// init, destroy
@@ -140,7 +155,7 @@ public:
 	void SetWorldScaleX( float sx );
 	void SetWorldScaleY( float sy );
 	
-	/// reset matrix on this object + descendants
+	/// reset matrix on this object ( descendants pick it up through generation counter )
 	void DirtyTransform();
 	
 	// get world transform
@@ -160,16 +175,16 @@ public:
 	GPU_Rect GetBounds();
 	
 	/// returns updated local transformation matrix
-	float* Transform();
+	Affine2D& Transform();
 	
 	/// returns updated world transformation matrix
-	float* WorldTransform();
+	Affine2D& WorldTransform();
 	
 	/// returns updated inverse world transformation matrix
-	float* InverseWorld();
+	Affine2D& InverseWorld();
 	
 	/// extracts local x, y, angle, and scale from matrix
-	void DecomposeTransform( float *te, b2Vec2& pos, float& angle, b2Vec2& scale );
+	void DecomposeTransform( Affine2D& te, b2Vec2& pos, float& angle, b2Vec2& scale );
 	
 	/// inverts source matrix, writes to dest, returns true on success
 	static bool MatrixInverse( float *source, float *dest );
@@ -218,7 +233,55 @@ public:
 
 	/// set to true to draw last
 	bool renderAfterChildren = false;
+
+	/// if true, this object and its children are skipped in Render when their bounds are outside of view
+	bool culling = true;
+
+	/// local-space bounding box of this object's render and all descendants ( w < 0 = empty )
+	GPU_Rect _subtreeBounds = { 0, 0, -1, -1 };
+
+	/// false if some part of subtree has bounds that can't be determined ( never culled )
+	bool _subtreeBounded = false;
+
+	/// true when _subtreeBounds need to be recalculated
+	bool _subtreeBoundsDirty = true;
+
+	/// marks subtree bounds of this object and its parents for recalculation
+	void InvalidateBounds();
+
+	/// recalculates subtree bounds if needed, returns _subtreeBounded
+	bool UpdateSubtreeBounds();
+	
+	/// app.frames when something affecting how this object or its descendants render last changed
+	int _renderChangedFrame = 0;
+	
+	/// app.frames when this object's own render or any descendant last changed ( own transform and opacity don't count, used by cached )
+	int _contentChangedFrame = 0;
 	
+	/// stamps this object and its parents as changed this frame ( used to skip redrawing cached renders, like Image.autoDraw ), ownContent = false for own transform changes
+	void RenderChanged( bool ownContent=true );
+	
+	/// native property was set from script
+	void NativePropertyChanged();
+	
+	/// if true, subtree is rendered into _cacheImage once, and drawn as a single quad until something in it changes
+	bool cached = false;
+	
+	/// offscreen render of this object and descendants, in local coordinates
+	Image* _cacheImage = NULL;
+	
+	/// app.frames when _cacheImage was last rendered
+	int _cacheFrame = 0;
+	
+	/// local rect _cacheImage covers
+	GPU_Rect _cacheRect = { 0, 0, 0, 0 };
+	
+	/// true while this object is being rendered into its own _cacheImage
+	bool _renderingCache = false;
+	
+	/// draws subtree from _cacheImage, re-rendering it once subtree has stopped changing. Returns false if subtree should be rendered live.
+	bool RenderCached( Event& event );
+
 // non-physics query
 	
 	/// raycasts from x, y in dx, dy direction, returns up to maxResults GameObjects with info
@@ -294,6 +357,18 @@ public:
 	/// calls handler for event on each behavior, then dispatches script event listeners on this GameObject
 	void CallEvent( Event& event );
 	
+	/// true if event is in this object's eventMask
+	bool MasksEvent( Event& event );
+	
+	/// true if a behavior, listener, or property function on this object handles event
+	bool SubscribesToEvent( EventId eventId );
+	
+	/// subscriptionsVersion when event handlers or hierarchy last changed in this subtree
+	uint32_t _subscriptionsVersion = 0;
+	
+	/// stamps this object and its ancestors, so subscriber lists of scene or overlay containing it are rebuilt
+	void SubscriptionsChanged();
+	
 };
 
 #endif /* GameObject_hpp */
@@ -87,7 +87,7 @@ void Image::InitClass() {
 		// object changed?
 		if ( img->autoDraw != go ) {
 			img->autoDraw = go;
-			img->lastRedrawFrame = 0;
+			img->ContentChanged();
 		}
 		return val;
 	}));
@@ -101,7 +101,10 @@ void Image::InitClass() {
 	 static_cast<ScriptObjectCallback>([](void *b, void* val) {
 		Image* img = (Image*) b;
 		GameObject* go = script.GetInstance<GameObject>( val );
-		img->autoMask = go;
+		if ( img->autoMask != go ) {
+			img->autoMask = go;
+			img->ContentChanged();
+		}
 		return val;
 	}));
 	
@@ -113,7 +116,10 @@ void Image::InitClass() {
 	}),
 	 static_cast<ScriptBoolCallback>([](void *b, bool val) {
 		Image* img = (Image*) b;
-		img->autoMaskInverted = val;
+		if ( img->autoMaskInverted != val ) {
+			img->autoMaskInverted = val;
+			img->ContentChanged();
+		}
 		return val;
 	}));
 	
@@ -171,6 +177,13 @@ void Image::InitClass() {
 		return true;
 	}));
 	
+	script.DefineFunction<Image>
+	( "redraw", // redraw() - forces autoDraw to redraw next time image is used
+	 static_cast<ScriptFunctionCallback>([]( void* obj, ScriptArguments& sa ) {
+		((Image*) obj)->ContentChanged();
+		return true;
+	}));
+	
 	script.DefineFunction<Image>
 	( "clear", // clear( [ Color clearColor | Int r, Int g, Int b [, Int a ] ] )
 	 static_cast<ScriptFunctionCallback>([]( void* o, ScriptArguments& sa ) {
@@ -203,6 +216,7 @@ void Image::InitClass() {
 		// clear
 		if ( img->image ) GPU_ClearColor( img->image->target, clr );
 		if ( img->mask ) GPU_Clear( img->mask->target );
+		img->ContentChanged();
 		
 		return true;
 	}));
@@ -230,6 +244,7 @@ void Image::InitClass() {
 		
 		// draw object
 		img->Draw( gameObject, false, x, y, angle, scaleX, scaleY );
+		img->ContentChanged();
 		return true;
 	}));
 	
@@ -257,6 +272,7 @@ void Image::InitClass() {
 		
 		// draw object
 		img->Draw( gameObject, true, x, y, angle, scaleX, scaleY );
+		img->ContentChanged();
 		img->ApplyMask( inverted );
 		return true;
 	}));
@@ -362,6 +378,7 @@ bool Image::FromDataURL( string &s ) {
 		GPU_FreeImage( this->image );
 	}
 	this->image = img;
+	this->ContentChanged();
 	GPU_UnsetImageVirtualResolution( img );
 	GPU_SetImageFilter( img, GPU_FILTER_NEAREST );
 	GPU_SetSnapMode( img, GPU_SNAP_NONE );
@@ -374,7 +391,7 @@ bool Image::FromDataURL( string &s ) {
 bool Image::FromTexture( string &s ) {
 	// load texture
 	ImageResource* res = app.textureManager.Get( s.c_str() );
-	if ( res && res->error == ResourceError::ERROR_NONE ) {
+	if ( res && res->error == ResourceError::ERROR_NONE && !res->IsLoading() ) {
 				
 		// make image
 		GPU_Image* src = res->mainResource ? res->mainResource->image : res->image;
@@ -411,6 +428,7 @@ bool Image::FromTexture( string &s ) {
 		}
 		// assign
 		this->image = img;
+		this->ContentChanged();
 		this->width = img->base_w;
 		this->height = img->base_h;
 		
@@ -483,11 +501,14 @@ GPU_Image* Image::MakeImage( bool makeMask ) {
 /// returns updated image
 GPU_Image* Image::GetImage() {
 	// check if needs redraw
-	if ( this->autoDraw && this->lastRedrawFrame < app.frames ) {
+	if ( this->autoDraw && this->lastRedrawFrame < app.frames && this->NeedsRedraw() ) {
 		this->lastRedrawFrame = app.frames;
+		this->_drawnTransform = this->autoDraw->Transform();
+		this->_drawnOpacity = this->autoDraw->parent ? this->autoDraw->parent->combinedOpacity : 1;
 		this->Draw( this->autoDraw, false );
 		// if have automask
 		if ( this->autoMask ) {
+			this->_drawnMaskTransform = this->autoMask->Transform();
 			this->Draw( this->autoMask, true );
 			this->ApplyMask( this->autoMaskInverted );
 		}
@@ -497,8 +518,32 @@ GPU_Image* Image::GetImage() {
 	return this->image;
 }
 
+/// image contents or auto draw settings changed
+void Image::ContentChanged() {
+	this->lastRedrawFrame = 0;
+	app.renderChangedFrame = app.frames;
+}
+
+/// true if autoDraw or autoMask changed since lastRedrawFrame
+bool Image::NeedsRedraw() {
+	
+	// never drawn, or resized
+	if ( !this->lastRedrawFrame || !this->image || this->image->w != this->width || this->image->h != this->height ) return true;
+	if ( this->autoMask && !this->mask ) return true;
+	
+	// something in subtree changed ( stamped during or after last redraw )
+	if ( this->autoDraw->_renderChangedFrame >= this->lastRedrawFrame ) return true;
+	if ( this->autoMask && this->autoMask->_renderChangedFrame >= this->lastRedrawFrame ) return true;
+	
+	// object itself moved, or its parent faded
+	if ( memcmp( &this->autoDraw->Transform(), &this->_drawnTransform, sizeof( Affine2D ) ) != 0 ) return true;
+	if ( this->autoMask && memcmp( &this->autoMask->Transform(), &this->_drawnMaskTransform, sizeof( Affine2D ) ) != 0 ) return true;
+	float opacity = this->autoDraw->parent ? this->autoDraw->parent->combinedOpacity : 1;
+	return ( opacity != this->_drawnOpacity );
+}
+
 /// draws gameobject
-void Image::Draw( GameObject* go, bool toMask, float x, float y, float angle, float scaleX, float scaleY ) {
+void Image::Draw( GameObject* go, bool toMask, float x, float y, float angle, float scaleX, float scaleY, const Affine2D* view ) {
 	
 	GPU_Image* curTarget = toMask ? this->mask : this->image;
 	
@@ -526,6 +571,7 @@ void Image::Draw( GameObject* go, bool toMask, float x, float y, float angle, fl
 	GPU_MatrixTranslate( mat, x, y, 0 );
 	GPU_MatrixRotate( mat, angle, 0, 0, 1 );
 	GPU_MatrixScale( mat, scaleX, scaleY, 1 );
+	if ( view ) view->MultiplyMatrix( mat );
 	GPU_MatrixCopy( GPU_GetCurrentMatrix(), mat );
 	
 	// set transform matrix
@@ -536,12 +582,15 @@ void Image::Draw( GameObject* go, bool toMask, float x, float y, float angle, fl
 	
 	// invoke render
 	Event renderEvent;
-	renderEvent.name = EVENT_RENDER;
+	renderEvent.SetId( EVENTID_RENDER );
 	renderEvent.behaviorParam = curTarget->target;
 	renderEvent.behaviorParam2 = toMask ? NULL : &this->blendTarget;
 	GPU_MatrixMode( GPU_MODELVIEW );
 	go->Render( renderEvent );
 	
+	// finish drawing into image before it's used
+	RenderBehavior::FlushSpriteBatch();
+	
 	// pop matrices
 	GPU_MatrixMode( GPU_PROJECTION );
 	GPU_PopMatrix();
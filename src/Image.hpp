@@ -25,11 +25,21 @@ public:
 	/// keeps track of last redraw
 	int lastRedrawFrame = 0;
 	
+	/// autoDraw / autoMask transforms and inherited opacity at last redraw
+	Affine2D _drawnTransform, _drawnMaskTransform;
+	float _drawnOpacity = 1;
+	
+	/// true if autoDraw or autoMask changed since lastRedrawFrame
+	bool NeedsRedraw();
+	
+	/// image contents or auto draw settings changed, redraws autoDraw on next use, and renders a new frame
+	void ContentChanged();
+	
 	/// helper to make/replace current image
 	GPU_Image* MakeImage( bool makingMask=false );
 	
-	/// draw gameobject
-	void Draw( GameObject* go, bool toMask=false, float x=0, float y=0, float angle=0, float scaleX=1, float scaleY=1 );
+	/// draw gameobject, view is applied after x, y, angle, scale
+	void Draw( GameObject* go, bool toMask=false, float x=0, float y=0, float angle=0, float scaleX=1, float scaleY=1, const Affine2D* view=NULL );
 	
 	/// applies mask to image
 	void ApplyMask( bool inverted );
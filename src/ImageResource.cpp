@@ -1,5 +1,8 @@
 #include "ImageResource.hpp"
 #include "Application.hpp"
+#include "RenderSpriteBehavior.hpp"
+#include <sys/mman.h>
+#include <fcntl.h>
 
 /* MARK:	-				Init / destroy
  -------------------------------------------------------------------- */
@@ -37,6 +40,7 @@ ImageResource::ImageResource( const char* originalKey, string& path, string& ext
 		// add main resource first
 		ImageResource* res = app.textureManager.Get( okey.c_str() );
 		this->mainResource = res;
+		res->frameResources++;
 		
 		// locate needed frame
 		ImageFramesIterator it = this->mainResource->frames.find( frame );
@@ -52,120 +56,32 @@ ImageResource::ImageResource( const char* originalKey, string& path, string& ext
 	}
 	
 	// if loading json + image
-	if ( ext.compare( "json" ) == 0 ) {
+	bool spriteSheet = ( ext.compare( "json" ) == 0 );
+	if ( spriteSheet ) {
 		
-		FILE *f = fopen( (char*) path.c_str(), "r" );
-		if ( f != NULL ) {
-			// get file size
-			fseek( f, 0, SEEK_END );
-			size_t fsize = (size_t) ftell( f );
-			fseek( f, 0, SEEK_SET );
-			// read file in
-			char *buf = (char*) malloc( sizeof( char ) * fsize + 1 );
-			buf[ fsize ] = 0;
-			fread(buf, sizeof(char), fsize, f );
-			string jsonString = buf;
-			free( buf );
-			fclose( f );
-			
-			// evaluate json to object
-			void *json = NULL;
-			if ( ( json = script.ParseJSON( jsonString.c_str() ) ) ) {
-				
-				// { frames: {....} }
-				ArgValue framesObj = script.GetProperty( "frames", json );
-				if ( framesObj.type == TypeObject && framesObj.value.objectValue ) {
-					// get names
-					ArgValueVector frameNames;
-					script.GetProperties( framesObj.value.objectValue, &frameNames, false, false, false );
-					ArgValueVector::iterator it = frameNames.begin(), end = frameNames.end();
-					string keyName;
+		// use binary cache if it's up to date, otherwise parse json and write cache
+		struct stat jsonStat;
+		if ( stat( path.c_str(), &jsonStat ) == 0 ) {
+			string cachePath = path.substr( 0, path.length() - ext.length() ) + "frames";
+			if ( !ImageResource::cacheFrames || !this->ReadFramesCache( cachePath, jsonStat ) ) {
+				FILE *f = fopen( (char*) path.c_str(), "r" );
+				if ( f != NULL ) {
+					// read file in
+					size_t fsize = (size_t) jsonStat.st_size;
+					char *buf = (char*) malloc( sizeof( char ) * fsize + 1 );
+					fsize = fread( buf, sizeof( char ), fsize, f );
+					buf[ fsize ] = 0;
+					fclose( f );
 					
-					// for each frame
-					while ( it != end ){
-						
-						// { frame:{x,y,w,h},rotated,trimmed,spriteSourceSize:{x,y,w,h},sourceSize:{w,h},pivot:{x,y} }
-						ArgValue frameObj = script.GetProperty( (*it).value.stringValue->c_str(), framesObj.value.objectValue );
-						
-						// strip extension from key
-						size_t extPos = (*it).value.stringValue->find_last_of( '.' );
-						keyName = (extPos != string::npos ? (*it).value.stringValue->substr( 0, extPos ) : (*it).value.stringValue->c_str() );
-						
-						// populate
-						ImageFrame frameInfo;
-						
-						// .rotated
-						ArgValue rotated = script.GetProperty( "rotated", frameObj.value.objectValue );
-						frameInfo.rotated = rotated.toBool();
-						
-						// .trimmed
-						ArgValue trimmed = script.GetProperty( "trimmed", frameObj.value.objectValue );
-						frameInfo.trimmed = trimmed.toBool();
-						
-						// .sourceSize
-						ArgValue subObj = script.GetProperty( "sourceSize", frameObj.value.objectValue );
-						if ( subObj.type == TypeObject ) {
-							ArgValue w = script.GetProperty( "w", subObj.value.objectValue );
-							ArgValue h = script.GetProperty( "h", subObj.value.objectValue );
-							w.toNumber( frameInfo.actualWidth );
-							h.toNumber( frameInfo.actualHeight );
-						} else {
-							printf( "%s - Error while loading \"%s.json\"", GetScriptNameAndLine().c_str(), path.c_str() );
-							break;
-						}
-
-						// .frame
-						subObj = script.GetProperty( "frame", frameObj.value.objectValue );
-						if ( subObj.type == TypeObject ) {
-							ArgValue x = script.GetProperty( "x", subObj.value.objectValue );
-							ArgValue y = script.GetProperty( "y", subObj.value.objectValue );
-							ArgValue w = script.GetProperty( "w", subObj.value.objectValue );
-							ArgValue h = script.GetProperty( "h", subObj.value.objectValue );
-							x.toNumber(frameInfo.locationOnTexture.x);
-							y.toNumber(frameInfo.locationOnTexture.y);
-							
-							if ( frameInfo.rotated ) {
-								w.toNumber( frameInfo.locationOnTexture.h );
-								h.toNumber( frameInfo.locationOnTexture.w );
-								frameInfo.trimWidth = frameInfo.actualWidth - frameInfo.locationOnTexture.h;
-								frameInfo.trimHeight = frameInfo.actualHeight - frameInfo.locationOnTexture.w;
-							} else {
-								w.toNumber( frameInfo.locationOnTexture.w );
-								h.toNumber( frameInfo.locationOnTexture.h );
-								frameInfo.trimWidth = frameInfo.actualWidth - frameInfo.locationOnTexture.w;
-								frameInfo.trimHeight = frameInfo.actualHeight - frameInfo.locationOnTexture.h;
-							}
-
-						} else {
-							printf( "%s - Error while loading \"%s.json\"", GetScriptNameAndLine().c_str(), path.c_str() );
-							break;
-						}
-						
-						// .spriteSourceSize
-						subObj = script.GetProperty( "spriteSourceSize", frameObj.value.objectValue );
-						if ( subObj.type == TypeObject ) {
-							ArgValue x = script.GetProperty( "x", subObj.value.objectValue );
-							ArgValue y = script.GetProperty( "y", subObj.value.objectValue );
-							x.toNumber( frameInfo.trimOffsetX );
-							y.toNumber( frameInfo.trimOffsetY );
-						} else {
-							printf( "%s - Error while loading \"%s.json\"", GetScriptNameAndLine().c_str(), path.c_str() );
-							break;
-						}
-						
-						// add to map
-						this->frames.insert( make_pair( keyName, frameInfo ) );
-						it++;
+					// parse, and cache
+					if ( this->ParseSpriteSheet( buf, fsize ) ) {
+						if ( ImageResource::cacheFrames ) this->WriteFramesCache( cachePath, jsonStat );
+					} else {
+						printf( "%s - Error while loading \"%s\"\n", GetScriptNameAndLine().c_str(), path.c_str() );
 					}
-					
-				} else {
-					printf( "%s - Error while loading \"%s.json\": object doesn't contain 'frames' property.\n", GetScriptNameAndLine().c_str(), path.c_str() );
+					free( buf );
 				}
-				// failed to parse
-			} else {
-				printf( "%s - Error while loading \"%s.json\": bad JSON\n", GetScriptNameAndLine().c_str(), path.c_str() );
 			}
-			
 		}
 		
 		// reattach image extension
@@ -174,6 +90,13 @@ ImageResource::ImageResource( const char* originalKey, string& path, string& ext
 		path = path + ext;
 	}
 	
+	// decode on loader thread, upload later
+	if ( ImageLoader::deferDecode ) {
+		this->loading = true;
+		ImageLoader::Queue( this, path, spriteSheet );
+		return;
+	}
+	
 	// load image
 	SDL_Surface* surface = IMG_Load( path.c_str() );
 	if ( surface == NULL ) {
@@ -183,11 +106,27 @@ ImageResource::ImageResource( const char* originalKey, string& path, string& ext
 		return;
 	}
 	
+	// make texture
+	this->UploadSurface( surface, spriteSheet );
+}
+
+/// creates texture from decoded surface ( or packs it into atlas ), frees surface
+void ImageResource::UploadSurface( SDL_Surface* surface, bool spriteSheet ) {
+	
 	// init bounds
 	this->frame.locationOnTexture = { 0, 0, (float) surface->clip_rect.w, (float) surface->clip_rect.h };
 	this->frame.actualWidth = this->frame.locationOnTexture.w;
 	this->frame.actualHeight = this->frame.locationOnTexture.h;
 	
+	// small loose image - pack into shared atlas
+	if ( !spriteSheet && ( this->atlasPage = TextureAtlas::Add( surface, this->atlasRect ) ) ) {
+		this->image = this->atlasPage->image;
+		this->frame.locationOnTexture.x = this->atlasRect.x + ATLAS_PADDING;
+		this->frame.locationOnTexture.y = this->atlasRect.y + ATLAS_PADDING;
+		SDL_FreeSurface( surface );
+		return;
+	}
+	
 	// convert to image
 	this->image = GPU_CopyImageFromSurface( surface );
 	this->image->anchor_x = this->image->anchor_y = 0; // reset
@@ -236,9 +175,9 @@ void ImageResource::AdjustUseCount( int increment ) {
 
 /// override base class
 bool ImageResource::CanUnload() {
-	// if this is a image map, forward call
-	if ( this->mainResource ) return this->mainResource->CanUnload();
-	else return Resource::CanUnload();
+	// if this is a image map, check sheet's use ( frames are unloaded before sheet )
+	if ( this->mainResource ) return !this->mainResource->loading && this->mainResource->Resource::CanUnload();
+	else return !this->loading && !this->HasDependents() && Resource::CanUnload();
 }
 
 /// load from png from memory
@@ -273,11 +212,683 @@ ImageResource::~ImageResource() {
 
 	//
 	// printf( "Unloading image %s\n", this->key.c_str() );
+	
+	// drop pending decode
+	if ( this->loading ) ImageLoader::Cancel( this );
+	
+	// release sprite sheet
+	if ( this->mainResource ) this->mainResource->frameResources--;
 
+	// return space on atlas page
+	if ( this->atlasPage ) {
+		TextureAtlas::Release( this->atlasPage, this->atlasRect );
 	// unload
-	if ( this->image ) {
+	} else if ( this->image ) {
 		GPU_FreeTarget( this->image->target );
 		GPU_FreeImage( this->image );
 	}
 	
 }
+
+/* MARK:	-				Sprite sheet
+ -------------------------------------------------------------------- */
+
+
+// static
+bool ImageResource::cacheFrames = true;
+
+/// minimal reader for sprite sheet json, reads values in place without creating script objects
+class SpriteSheetReader {
+public:
+	
+	const char *p, *end;
+	
+	SpriteSheetReader( const char* json, size_t length ) : p( json ), end( json + length ) {}
+	
+	void SkipSpace() {
+		while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' ) ) p++;
+	}
+	
+	/// consumes character c, returns false if it's not next
+	bool Expect( char c ) {
+		SkipSpace();
+		if ( p >= end || *p != c ) return false;
+		p++;
+		return true;
+	}
+	
+	/// reads string ( non-ascii \u escapes become '?' )
+	bool ReadString( string& out ) {
+		out.clear();
+		if ( !Expect( '"' ) ) return false;
+		while ( p < end && *p != '"' ) {
+			if ( *p == '\\' && p + 1 < end ) {
+				p++;
+				switch ( *p ) {
+					case 'n': out += '\n'; break;
+					case 't': out += '\t'; break;
+					case 'r': out += '\r'; break;
+					case 'b': out += '\b'; break;
+					case 'f': out += '\f'; break;
+					case 'u':
+						if ( p + 4 >= end ) return false;
+						{
+							int code = (int) strtol( string( p + 1, 4 ).c_str(), NULL, 16 );
+							out += ( code < 128 ? (char) code : '?' );
+						}
+						p += 4;
+						break;
+					default: out += *p; break;
+				}
+			} else out += *p;
+			p++;
+		}
+		if ( p >= end ) return false;
+		p++;
+		return true;
+	}
+	
+	/// moves to next key in object, returns false at the end of object ( or on error )
+	bool NextKey( string& key ) {
+		SkipSpace();
+		if ( p < end && *p == ',' ) p++;
+		SkipSpace();
+		if ( p >= end ) return false;
+		if ( *p == '}' ) { p++; return false; }
+		return ReadString( key ) && Expect( ':' );
+	}
+	
+	/// skips over any value
+	bool SkipValue() {
+		SkipSpace();
+		if ( p >= end ) return false;
+		if ( *p == '"' ) {
+			string s;
+			return ReadString( s );
+		} else if ( *p == '{' || *p == '[' ) {
+			int depth = 0;
+			while ( p < end ) {
+				if ( *p == '"' ) {
+					string s;
+					if ( !ReadString( s ) ) return false;
+					continue;
+				}
+				if ( *p == '{' || *p == '[' ) depth++;
+				else if ( *p == '}' || *p == ']' ) {
+					if ( --depth == 0 ) { p++; return true; }
+				}
+				p++;
+			}
+			return false;
+		}
+		// number, true, false, null
+		while ( p < end && *p != ',' && *p != '}' && *p != ']' ) p++;
+		return true;
+	}
+	
+	/// reads number, leaves out unchanged if value isn't a number
+	bool ReadNumber( float& out ) {
+		SkipSpace();
+		char* numEnd = NULL;
+		float val = strtof( p, &numEnd );
+		if ( numEnd == p ) return SkipValue();
+		out = val;
+		p = numEnd;
+		return true;
+	}
+	
+	/// reads true or false
+	bool ReadBool( bool& out ) {
+		SkipSpace();
+		out = ( end - p >= 4 && strncmp( p, "true", 4 ) == 0 );
+		return SkipValue();
+	}
+	
+	/// reads { x, y, w, h } object, returns false on error
+	bool ReadRect( GPU_Rect& rect ) {
+		if ( !Expect( '{' ) ) return false;
+		string key;
+		while ( NextKey( key ) ) {
+			bool ok = true;
+			if ( key.compare( "x" ) == 0 ) ok = ReadNumber( rect.x );
+			else if ( key.compare( "y" ) == 0 ) ok = ReadNumber( rect.y );
+			else if ( key.compare( "w" ) == 0 ) ok = ReadNumber( rect.w );
+			else if ( key.compare( "h" ) == 0 ) ok = ReadNumber( rect.h );
+			else ok = SkipValue();
+			if ( !ok ) return false;
+		}
+		return true;
+	}
+	
+};
+
+/// parses free-tex-packer json into frames, returns false on error
+bool ImageResource::ParseSpriteSheet( const char* json, size_t length ) {
+	
+	// { frames: { "name.png": { frame:{x,y,w,h},rotated,trimmed,spriteSourceSize:{x,y,w,h},sourceSize:{w,h},pivot:{x,y} }, ... }, meta: {...} }
+	SpriteSheetReader reader( json, length );
+	if ( !reader.Expect( '{' ) ) return false;
+	string key, frameName, keyName;
+	bool foundFrames = false;
+	while ( reader.NextKey( key ) ) {
+		
+		// skip everything but frames
+		if ( key.compare( "frames" ) != 0 ) {
+			if ( !reader.SkipValue() ) return false;
+			continue;
+		}
+		foundFrames = true;
+		if ( !reader.Expect( '{' ) ) return false;
+		
+		// for each frame
+		while ( reader.NextKey( frameName ) ) {
+			
+			// populate
+			ImageFrame frameInfo;
+			GPU_Rect frameRect = { 0, 0, 0, 0 }, spriteSourceRect = { 0, 0, 0, 0 }, sourceRect = { 0, 0, 0, 0 };
+			bool hasFrame = false, hasSpriteSource = false, hasSource = false;
+			if ( !reader.Expect( '{' ) ) return false;
+			while ( reader.NextKey( key ) ) {
+				bool ok = true;
+				if ( key.compare( "frame" ) == 0 ) ok = hasFrame = reader.ReadRect( frameRect );
+				else if ( key.compare( "spriteSourceSize" ) == 0 ) ok = hasSpriteSource = reader.ReadRect( spriteSourceRect );
+				else if ( key.compare( "sourceSize" ) == 0 ) ok = hasSource = reader.ReadRect( sourceRect );
+				else if ( key.compare( "rotated" ) == 0 ) ok = reader.ReadBool( frameInfo.rotated );
+				else if ( key.compare( "trimmed" ) == 0 ) ok = reader.ReadBool( frameInfo.trimmed );
+				else ok = reader.SkipValue();
+				if ( !ok ) return false;
+			}
+			if ( !hasFrame || !hasSpriteSource || !hasSource ) return false;
+			
+			// rotated frames are stored with w and h swapped
+			frameInfo.actualWidth = sourceRect.w;
+			frameInfo.actualHeight = sourceRect.h;
+			frameInfo.locationOnTexture.x = frameRect.x;
+			frameInfo.locationOnTexture.y = frameRect.y;
+			frameInfo.locationOnTexture.w = frameInfo.rotated ? frameRect.h : frameRect.w;
+			frameInfo.locationOnTexture.h = frameInfo.rotated ? frameRect.w : frameRect.h;
+			frameInfo.trimWidth = frameInfo.actualWidth - frameRect.w;
+			frameInfo.trimHeight = frameInfo.actualHeight - frameRect.h;
+			frameInfo.trimOffsetX = spriteSourceRect.x;
+			frameInfo.trimOffsetY = spriteSourceRect.y;
+			
+			// strip extension from key, and add to map
+			size_t extPos = frameName.find_last_of( '.' );
+			keyName = ( extPos != string::npos ? frameName.substr( 0, extPos ) : frameName );
+			this->frames[ keyName ] = frameInfo;
+		}
+	}
+	return foundFrames;
+}
+
+/*
+ .frames cache layout: FramesCacheHeader, then for each frame:
+ Uint16 name length, name chars, FramesCacheRecord
+*/
+
+#define FRAMES_CACHE_MAGIC		0x52465641 // "AVFR"
+#define FRAMES_CACHE_VERSION	1
+
+typedef struct {
+	Uint32 magic;
+	Uint32 version;
+	Sint64 sourceTime;
+	Sint64 sourceSize;
+	Uint32 numFrames;
+} FramesCacheHeader;
+
+typedef struct {
+	float x, y, w, h;
+	float trimOffsetX, trimOffsetY;
+	float actualWidth, actualHeight;
+	float trimWidth, trimHeight;
+	Uint8 rotated, trimmed;
+} FramesCacheRecord;
+
+/// reads frames from binary cache, returns false if it's missing or doesn't match json
+bool ImageResource::ReadFramesCache( string& cachePath, struct stat& jsonStat ) {
+	
+	// map file
+	int fd = open( cachePath.c_str(), O_RDONLY );
+	if ( fd < 0 ) return false;
+	struct stat cacheStat;
+	if ( fstat( fd, &cacheStat ) != 0 || cacheStat.st_size < (off_t) sizeof( FramesCacheHeader ) ) {
+		close( fd );
+		return false;
+	}
+	size_t size = (size_t) cacheStat.st_size;
+	void* data = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd );
+	if ( data == MAP_FAILED ) return false;
+	
+	// validate
+	const char *p = (const char*) data, *end = p + size;
+	FramesCacheHeader header;
+	memcpy( &header, p, sizeof( header ) );
+	p += sizeof( header );
+	bool ok = ( header.magic == FRAMES_CACHE_MAGIC && header.version == FRAMES_CACHE_VERSION &&
+			    header.sourceTime == (Sint64) jsonStat.st_mtime && header.sourceSize == (Sint64) jsonStat.st_size );
+	
+	// read frames
+	ImageFramesMap cached;
+	for ( Uint32 i = 0; ok && i < header.numFrames; i++ ) {
+		Uint16 nameLength = 0;
+		FramesCacheRecord rec;
+		if ( end - p < (ptrdiff_t) sizeof( Uint16 ) ) { ok = false; break; }
+		memcpy( &nameLength, p, sizeof( Uint16 ) );
+		p += sizeof( Uint16 );
+		if ( end - p < (ptrdiff_t) ( nameLength + sizeof( rec ) ) ) { ok = false; break; }
+		string name( p, nameLength );
+		p += nameLength;
+		memcpy( &rec, p, sizeof( rec ) );
+		p += sizeof( rec );
+		
+		ImageFrame& frameInfo = cached[ name ];
+		frameInfo.locationOnTexture = { rec.x, rec.y, rec.w, rec.h };
+		frameInfo.trimOffsetX = rec.trimOffsetX; frameInfo.trimOffsetY = rec.trimOffsetY;
+		frameInfo.actualWidth = rec.actualWidth; frameInfo.actualHeight = rec.actualHeight;
+		frameInfo.trimWidth = rec.trimWidth; frameInfo.trimHeight = rec.trimHeight;
+		frameInfo.rotated = rec.rotated; frameInfo.trimmed = rec.trimmed;
+	}
+	munmap( data, size );
+	if ( ok ) this->frames.swap( cached );
+	return ok;
+}
+
+/// writes frames to binary cache ( silently skipped if directory isn't writable )
+void ImageResource::WriteFramesCache( string& cachePath, struct stat& jsonStat ) {
+	
+	FILE *f = fopen( cachePath.c_str(), "wb" );
+	if ( !f ) return;
+	
+	// header
+	FramesCacheHeader header;
+	memset( &header, 0, sizeof( header ) );
+	header.magic = FRAMES_CACHE_MAGIC;
+	header.version = FRAMES_CACHE_VERSION;
+	header.sourceTime = (Sint64) jsonStat.st_mtime;
+	header.sourceSize = (Sint64) jsonStat.st_size;
+	header.numFrames = (Uint32) this->frames.size();
+	bool ok = fwrite( &header, sizeof( header ), 1, f ) == 1;
+	
+	// frames
+	ImageFramesIterator it = this->frames.begin(), end = this->frames.end();
+	while ( ok && it != end ) {
+		ImageFrame& frameInfo = it->second;
+		FramesCacheRecord rec;
+		memset( &rec, 0, sizeof( rec ) );
+		rec.x = frameInfo.locationOnTexture.x; rec.y = frameInfo.locationOnTexture.y;
+		rec.w = frameInfo.locationOnTexture.w; rec.h = frameInfo.locationOnTexture.h;
+		rec.trimOffsetX = frameInfo.trimOffsetX; rec.trimOffsetY = frameInfo.trimOffsetY;
+		rec.actualWidth = frameInfo.actualWidth; rec.actualHeight = frameInfo.actualHeight;
+		rec.trimWidth = frameInfo.trimWidth; rec.trimHeight = frameInfo.trimHeight;
+		rec.rotated = frameInfo.rotated; rec.trimmed = frameInfo.trimmed;
+		Uint16 nameLength = (Uint16) min( it->first.length(), (size_t) 0xFFFF );
+		ok = fwrite( &nameLength, sizeof( Uint16 ), 1, f ) == 1 &&
+			 fwrite( it->first.c_str(), 1, nameLength, f ) == nameLength &&
+			 fwrite( &rec, sizeof( rec ), 1, f ) == 1;
+		it++;
+	}
+	fclose( f );
+	
+	// don't leave partial file
+	if ( !ok ) remove( cachePath.c_str() );
+}
+
+
+/* MARK:	-				Texture atlas
+ -------------------------------------------------------------------- */
+
+
+// static
+vector<TextureAtlasPage*> TextureAtlas::pages;
+bool TextureAtlas::enabled = true;
+
+/// copies surface to atlas, returns page and its padded rect on it, or NULL if surface doesn't qualify
+TextureAtlasPage* TextureAtlas::Add( SDL_Surface* surface, GPU_Rect& outRect ) {
+	
+	// only small images
+	int w = surface->clip_rect.w, h = surface->clip_rect.h;
+	if ( !enabled || w <= 0 || h <= 0 || w > ATLAS_MAX_IMAGE_SIZE || h > ATLAS_MAX_IMAGE_SIZE ) return NULL;
+	
+	// find page with space, or add one
+	int pw = w + ATLAS_PADDING * 2, ph = h + ATLAS_PADDING * 2;
+	TextureAtlasPage* page = NULL;
+	for ( size_t i = 0, np = pages.size(); i < np && !page; i++ ) {
+		if ( pages[ i ]->Allocate( pw, ph, outRect ) ) page = pages[ i ];
+	}
+	if ( !page ) {
+		page = new TextureAtlasPage();
+		if ( !page->image || !page->Allocate( pw, ph, outRect ) ) {
+			delete page;
+			return NULL;
+		}
+		pages.push_back( page );
+	}
+	
+	// copy image
+	page->Copy( surface, outRect );
+	page->numFrames++;
+	return page;
+	
+}
+
+/// releases rect back to page, frees page if it's empty
+void TextureAtlas::Release( TextureAtlasPage* page, GPU_Rect& rect ) {
+	page->Release( rect );
+	if ( page->numFrames <= 0 ) {
+		vector<TextureAtlasPage*>::iterator it = find( pages.begin(), pages.end(), page );
+		if ( it != pages.end() ) pages.erase( it );
+		delete page;
+	}
+}
+
+TextureAtlasPage::TextureAtlasPage() {
+	
+	// create texture
+	this->image = GPU_CreateImage( ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, GPU_FORMAT_RGBA );
+	if ( !this->image ) return;
+	this->image->anchor_x = this->image->anchor_y = 0;
+	GPU_SetImageFilter( this->image, GPU_FILTER_NEAREST );
+	GPU_SetSnapMode( this->image, GPU_SNAP_NONE );
+	GPU_SetWrapMode( this->image, GPU_WRAP_NONE, GPU_WRAP_NONE );
+	
+	// empty skyline
+	this->skyline.push_back( { 0, 0, ATLAS_PAGE_SIZE } );
+	
+}
+
+TextureAtlasPage::~TextureAtlasPage() {
+	if ( this->image ) GPU_FreeImage( this->image );
+}
+
+/// returns y at which w x h fits on skyline starting at node index, or -1
+int TextureAtlasPage::SkylineFit( size_t index, int w, int h ) {
+	int x = this->skyline[ index ].x;
+	if ( x + w > ATLAS_PAGE_SIZE ) return -1;
+	int widthLeft = w, y = this->skyline[ index ].y;
+	size_t i = index, ns = this->skyline.size();
+	while ( widthLeft > 0 ) {
+		if ( i >= ns ) return -1;
+		y = max( y, this->skyline[ i ].y );
+		if ( y + h > ATLAS_PAGE_SIZE ) return -1;
+		widthLeft -= this->skyline[ i ].w;
+		i++;
+	}
+	return y;
+}
+
+/// finds space for w x h rectangle, returns false if page is full
+bool TextureAtlasPage::Allocate( int w, int h, GPU_Rect& outRect ) {
+	
+	// smallest released area that fits
+	int bestFree = -1;
+	float bestArea = 0;
+	for ( size_t i = 0, nf = this->freeRects.size(); i < nf; i++ ) {
+		GPU_Rect& fr = this->freeRects[ i ];
+		float area = fr.w * fr.h;
+		if ( fr.w >= w && fr.h >= h && ( bestFree < 0 || area < bestArea ) ) {
+			bestFree = (int) i;
+			bestArea = area;
+		}
+	}
+	if ( bestFree >= 0 ) {
+		// split remainder into right and bottom parts
+		GPU_Rect fr = this->freeRects[ bestFree ];
+		this->freeRects.erase( this->freeRects.begin() + bestFree );
+		if ( fr.w > w ) this->freeRects.push_back( { fr.x + w, fr.y, fr.w - w, (float) h } );
+		if ( fr.h > h ) this->freeRects.push_back( { fr.x, fr.y + h, fr.w, fr.h - h } );
+		outRect = { fr.x, fr.y, (float) w, (float) h };
+		return true;
+	}
+	
+	// bottom-left position on skyline
+	int bestIndex = -1, bestY = ATLAS_PAGE_SIZE, bestWidth = ATLAS_PAGE_SIZE;
+	for ( size_t i = 0, ns = this->skyline.size(); i < ns; i++ ) {
+		int y = this->SkylineFit( i, w, h );
+		if ( y >= 0 && ( y + h < bestY || ( y + h == bestY && this->skyline[ i ].w < bestWidth ) ) ) {
+			bestIndex = (int) i;
+			bestY = y + h;
+			bestWidth = this->skyline[ i ].w;
+		}
+	}
+	if ( bestIndex < 0 ) return false;
+	
+	// add segment
+	SkylineNode node = { this->skyline[ bestIndex ].x, bestY, w };
+	outRect = { (float) node.x, (float) ( bestY - h ), (float) w, (float) h };
+	this->skyline.insert( this->skyline.begin() + bestIndex, node );
+	
+	// trim segments covered by new one
+	for ( size_t i = bestIndex + 1; i < this->skyline.size(); ) {
+		SkylineNode& prev = this->skyline[ i - 1 ];
+		SkylineNode& cur = this->skyline[ i ];
+		int overlap = prev.x + prev.w - cur.x;
+		if ( overlap <= 0 ) break;
+		cur.x += overlap;
+		cur.w -= overlap;
+		if ( cur.w > 0 ) break;
+		this->skyline.erase( this->skyline.begin() + i );
+	}
+	
+	// merge segments at same height
+	for ( size_t i = 0; i + 1 < this->skyline.size(); ) {
+		if ( this->skyline[ i ].y == this->skyline[ i + 1 ].y ) {
+			this->skyline[ i ].w += this->skyline[ i + 1 ].w;
+			this->skyline.erase( this->skyline.begin() + i + 1 );
+		} else i++;
+	}
+	return true;
+	
+}
+
+/// returns rectangle to page
+void TextureAtlasPage::Release( GPU_Rect& rect ) {
+	this->numFrames--;
+	this->freeRects.push_back( rect );
+}
+
+/// clears padded rect, and copies surface inside padding
+void TextureAtlasPage::Copy( SDL_Surface* surface, GPU_Rect& paddedRect ) {
+	
+	// clear padded area (may contain pixels of released image)
+	int pw = (int) paddedRect.w, ph = (int) paddedRect.h;
+	vector<unsigned char> clear( pw * ph * 4, 0 );
+	GPU_UpdateImageBytes( this->image, &paddedRect, clear.data(), pw * 4 );
+	
+	// copy surface
+	GPU_Rect imageRect = { paddedRect.x + ATLAS_PADDING, paddedRect.y + ATLAS_PADDING, (float) surface->w, (float) surface->h };
+	GPU_Rect surfaceRect = { 0, 0, (float) surface->w, (float) surface->h };
+	GPU_UpdateImage( this->image, &imageRect, surface, &surfaceRect );
+	
+}
+
+
+/* MARK:	-				Image loader
+ -------------------------------------------------------------------- */
+
+
+// static
+bool ImageLoader::deferDecode = false;
+Uint32 ImageLoader::uploadBudget = 4;
+list<ImageLoader::Batch> ImageLoader::batches;
+unordered_set<RenderSpriteBehavior*> ImageLoader::sizePendingSprites;
+vector<SDL_Thread*> ImageLoader::threads;
+SDL_mutex* ImageLoader::mutex = NULL;
+SDL_cond* ImageLoader::condition = NULL;
+list<ImageLoader::Request*> ImageLoader::pending;
+list<ImageLoader::Request*> ImageLoader::done;
+list<ImageLoader::Request*> ImageLoader::requests;
+bool ImageLoader::quit = false;
+
+/// returns texture resource, starting background load if it isn't loaded yet
+ImageResource* ImageLoader::Load( const char* key ) {
+	deferDecode = true;
+	ImageResource* res = app.textureManager.Get( key );
+	deferDecode = false;
+	return res;
+}
+
+/// queues decoding of image file for resource
+void ImageLoader::Queue( ImageResource* resource, string& path, bool spriteSheet ) {
+	
+	// start workers
+	if ( !mutex ) {
+		mutex = SDL_CreateMutex();
+		condition = SDL_CreateCond();
+		quit = false;
+		int numThreads = max( 1, min( IMAGE_LOADER_MAX_THREADS, SDL_GetCPUCount() - 1 ) );
+		for ( int i = 0; i < numThreads; i++ ) {
+			SDL_Thread* thread = SDL_CreateThread( ImageLoader::Worker, "ImageLoader", NULL );
+			if ( thread ) threads.push_back( thread );
+		}
+	}
+	
+	// add request
+	Request* req = new Request();
+	req->resource = resource;
+	req->path = path;
+	req->spriteSheet = spriteSheet;
+	req->surface = NULL;
+	SDL_LockMutex( mutex );
+	requests.push_back( req );
+	pending.push_back( req );
+	SDL_CondSignal( condition );
+	SDL_UnlockMutex( mutex );
+}
+
+/// forgets requests for resource being destroyed
+void ImageLoader::Cancel( ImageResource* resource ) {
+	if ( !mutex ) return;
+	SDL_LockMutex( mutex );
+	list<Request*>::iterator it = requests.begin(), end = requests.end();
+	while ( it != end ) {
+		if ( (*it)->resource == resource ) (*it)->resource = NULL;
+		it++;
+	}
+	SDL_UnlockMutex( mutex );
+}
+
+/// decodes pending requests
+int ImageLoader::Worker( void* ) {
+	SDL_LockMutex( mutex );
+	while ( !quit ) {
+		
+		// wait for request
+		if ( pending.empty() ) {
+			SDL_CondWait( condition, mutex );
+			continue;
+		}
+		Request* req = pending.front();
+		pending.pop_front();
+		
+		// decode unlocked
+		SDL_UnlockMutex( mutex );
+		req->surface = IMG_Load( req->path.c_str() );
+		SDL_LockMutex( mutex );
+		done.push_back( req );
+	}
+	SDL_UnlockMutex( mutex );
+	return 0;
+}
+
+/// uploads decoded images within budget, calls completed batch callbacks ( called by game loop )
+void ImageLoader::ProcessLoaded() {
+	
+	// upload decoded
+	bool uploaded = false;
+	if ( mutex ) {
+		Uint32 start = SDL_GetTicks();
+		do {
+			// take next
+			SDL_LockMutex( mutex );
+			Request* req = NULL;
+			ImageResource* res = NULL;
+			if ( !done.empty() ) {
+				req = done.front();
+				done.pop_front();
+				requests.remove( req );
+				res = req->resource;
+			}
+			SDL_UnlockMutex( mutex );
+			if ( !req ) break;
+			
+			// resource still exists
+			if ( res ) {
+				res->loading = false;
+				if ( req->surface ) {
+					res->UploadSurface( req->surface, req->spriteSheet );
+				} else {
+					printf( "Texture %s was not found\n", req->path.c_str() );
+					res->error = ERROR_NOT_FOUND;
+				}
+			} else if ( req->surface ) {
+				SDL_FreeSurface( req->surface );
+			}
+			delete req;
+			uploaded = true;
+			
+		} while ( SDL_GetTicks() - start < uploadBudget );
+	}
+	
+	// size sprites waiting for uploaded textures ( bounds are correct before they're culled, laid out, or hit tested )
+	if ( uploaded ) {
+		auto sit = sizePendingSprites.begin();
+		while ( sit != sizePendingSprites.end() ) {
+			RenderSpriteBehavior* sprite = *sit++;
+			if ( !sprite->imageResource || !sprite->imageResource->IsLoading() ) sprite->TextureLoaded();
+		}
+	}
+	
+	// completed batches
+	list<Batch>::iterator it = batches.begin();
+	while ( it != batches.end() ) {
+		Batch& batch = *it;
+		bool complete = true, success = true;
+		for ( size_t i = 0, nr = batch.resources.size(); i < nr && complete; i++ ) {
+			ImageResource* res = batch.resources[ i ];
+			complete = !res->IsLoading();
+			success = success && res->error == ERROR_NONE;
+		}
+		if ( !complete ) { it++; continue; }
+		
+		// release, and remove before calling, in case callback preloads more
+		for ( size_t i = 0, nr = batch.resources.size(); i < nr; i++ ) batch.resources[ i ]->AdjustUseCount( -1 );
+		ScriptFunctionObject callback = batch.callback;
+		it = batches.erase( it );
+		if ( callback.funcObject ) {
+			ScriptArguments args;
+			args.AddBoolArgument( success );
+			callback.Invoke( args );
+		}
+	}
+}
+
+/// stops worker threads, discards unfinished requests
+void ImageLoader::Shutdown() {
+	if ( !mutex ) return;
+	
+	// stop workers
+	SDL_LockMutex( mutex );
+	quit = true;
+	SDL_CondBroadcast( condition );
+	SDL_UnlockMutex( mutex );
+	for ( size_t i = 0, nt = threads.size(); i < nt; i++ ) SDL_WaitThread( threads[ i ], NULL );
+	threads.clear();
+	
+	// discard requests
+	list<Request*>::iterator it = requests.begin(), end = requests.end();
+	while ( it != end ) {
+		if ( (*it)->surface ) SDL_FreeSurface( (*it)->surface );
+		if ( (*it)->resource ) (*it)->resource->loading = false;
+		delete *it;
+		it++;
+	}
+	requests.clear(); pending.clear(); done.clear();
+	batches.clear();
+	
+	SDL_DestroyCond( condition );
+	SDL_DestroyMutex( mutex );
+	condition = NULL;
+	mutex = NULL;
+}
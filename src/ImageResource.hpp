@@ -2,6 +2,9 @@
 #define ImageResource_hpp
 
 #include "ResourceManager.hpp"
+#include "ScriptArguments.hpp"
+
+class RenderSpriteBehavior;
 
 /* MARK:	-				Image resource
  
@@ -24,6 +27,72 @@ typedef struct {
 typedef unordered_map<string, ImageFrame> ImageFramesMap;
 typedef unordered_map<string, ImageFrame>::iterator ImageFramesIterator;
 
+/* MARK:	-				Texture atlas
+ 
+ Loose images up to ATLAS_MAX_IMAGE_SIZE are packed at load time into shared
+ ATLAS_PAGE_SIZE textures, so sprites using them can be drawn in one batch.
+ Pages are packed using skyline bottom-left, areas of unloaded images are reused.
+ -------------------------------------------------------------------- */
+
+#define ATLAS_PAGE_SIZE			1024
+#define ATLAS_MAX_IMAGE_SIZE	256
+#define ATLAS_PADDING			1
+
+/// single shared texture
+class TextureAtlasPage {
+public:
+	
+	/// texture
+	GPU_Image* image = NULL;
+	
+	/// number of images currently on this page
+	int numFrames = 0;
+	
+	/// top edge of packed area, as horizontal segments
+	typedef struct { int x, y, w; } SkylineNode;
+	vector<SkylineNode> skyline;
+	
+	/// areas released by unloaded images
+	vector<GPU_Rect> freeRects;
+	
+	/// finds space for w x h rectangle, returns false if page is full
+	bool Allocate( int w, int h, GPU_Rect& outRect );
+	
+	/// returns rectangle to page
+	void Release( GPU_Rect& rect );
+	
+	/// clears padded rect, and copies surface inside padding
+	void Copy( SDL_Surface* surface, GPU_Rect& paddedRect );
+	
+	// init, destroy
+	TextureAtlasPage();
+	~TextureAtlasPage();
+	
+private:
+	
+	/// returns y at which w x h fits on skyline starting at node index, or -1
+	int SkylineFit( size_t index, int w, int h );
+	
+};
+
+/// runtime texture atlas
+class TextureAtlas {
+public:
+	
+	/// all pages
+	static vector<TextureAtlasPage*> pages;
+	
+	/// set to false to load each image into its own texture
+	static bool enabled;
+	
+	/// copies surface to atlas, returns page and its padded rect on it, or NULL if surface doesn't qualify
+	static TextureAtlasPage* Add( SDL_Surface* surface, GPU_Rect& outRect );
+	
+	/// releases rect back to page, frees page if it's empty
+	static void Release( TextureAtlasPage* page, GPU_Rect& rect );
+	
+};
+
 class ImageResource : public Resource {
 public:
 	
@@ -39,6 +108,37 @@ public:
 	/// in sprite sheets points to main resource (image is NULL)
 	ImageResource* mainResource = NULL;
 	
+	/// number of frame resources pointing to this sprite sheet ( sheet isn't unloaded until they are )
+	int frameResources = 0;
+	bool HasDependents() { return this->frameResources > 0; }
+	
+	/// if packed into runtime atlas, page (image points to page's texture)
+	TextureAtlasPage* atlasPage = NULL;
+	
+	/// padded area occupied on atlas page
+	GPU_Rect atlasRect = { 0, 0, 0, 0 };
+	
+	/// true while image is being decoded by ImageLoader ( image is NULL, loose image frame is empty )
+	bool loading = false;
+	
+	/// true if this, or sprite sheet this frame is on is still loading
+	bool IsLoading() { return this->mainResource ? this->mainResource->loading : this->loading; }
+	
+	/// creates texture from decoded surface ( or packs it into atlas ), frees surface
+	void UploadSurface( SDL_Surface* surface, bool spriteSheet );
+	
+	/// set to false to always parse sprite sheet json, instead of using .frames cache next to it
+	static bool cacheFrames;
+	
+	/// parses free-tex-packer json into frames, returns false on error
+	bool ParseSpriteSheet( const char* json, size_t length );
+	
+	/// reads frames from binary cache, returns false if it's missing or doesn't match json
+	bool ReadFramesCache( string& cachePath, struct stat& jsonStat );
+	
+	/// writes frames to binary cache
+	void WriteFramesCache( string& cachePath, struct stat& jsonStat );
+	
 	// override use count
 	void AdjustUseCount( int increment );
 	bool CanUnload();
@@ -55,4 +155,87 @@ public:
 };
 
 
+/* MARK:	-				Image loader
+ 
+ Decodes image files on worker threads. ImageResources created while
+ ImageLoader::deferDecode is set are returned right away with loading = true.
+ Decoded surfaces are uploaded in ProcessLoaded, called once per frame by
+ game loop, until uploadBudget milliseconds are spent.
+ -------------------------------------------------------------------- */
+
+#define IMAGE_LOADER_MAX_THREADS	2
+
+class ImageLoader {
+public:
+	
+	/// single decode request
+	typedef struct {
+		ImageResource* resource; // NULL if resource was unloaded before completion
+		string path;
+		bool spriteSheet;
+		SDL_Surface* surface;
+	} Request;
+	
+	/// group of textures started with preload(), callback is called once all are loaded
+	typedef struct {
+		vector<ImageResource*> resources;
+		ScriptFunctionObject callback;
+	} Batch;
+	
+	/// when true, new ImageResources queue decoding instead of loading immediately
+	static bool deferDecode;
+	
+	/// milliseconds per frame spent uploading decoded images ( at least one is uploaded each frame )
+	static Uint32 uploadBudget;
+	
+	/// preload batches waiting for completion
+	static list<Batch> batches;
+	
+	/// sprites assigned a loading texture, resized when it's uploaded
+	static unordered_set<RenderSpriteBehavior*> sizePendingSprites;
+	
+	/// returns texture resource, starting background load if it isn't loaded yet
+	static ImageResource* Load( const char* key );
+	
+	/// queues decoding of image file for resource
+	static void Queue( ImageResource* resource, string& path, bool spriteSheet );
+	
+	/// forgets requests for resource being destroyed
+	static void Cancel( ImageResource* resource );
+	
+	/// uploads decoded images within budget, calls completed batch callbacks ( called by game loop )
+	static void ProcessLoaded();
+	
+	/// stops worker threads, discards unfinished requests
+	static void Shutdown();
+	
+private:
+	
+	/// worker threads, started with first request
+	static vector<SDL_Thread*> threads;
+	
+	/// guards queues below
+	static SDL_mutex* mutex;
+	
+	/// signalled when request is queued
+	static SDL_cond* condition;
+	
+	/// requests waiting to be decoded
+	static list<Request*> pending;
+	
+	/// decoded requests waiting for upload
+	static list<Request*> done;
+	
+	/// all requests not yet uploaded
+	static list<Request*> requests;
+	
+	/// tells workers to exit
+	static bool quit;
+	
+	/// decodes pending requests
+	static int Worker( void* );
+	
+};
+
+
 #endif /* ImageResource_hpp */
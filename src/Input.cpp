@@ -456,7 +456,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 	Controller* joy = NULL;
 	if ( etype == SDL_KEYDOWN && ( repeatKeyEnabled || e.key.repeat == 0 ) ) {
 		joy = joysticks[ -9999 ];
-		event.name = EVENT_KEYDOWN;
+		event.SetId( EVENTID_KEYDOWN );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.key.keysym.scancode );
@@ -469,7 +469,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		UIEvent( event );
 	} else if ( etype == SDL_KEYUP ) {
 		joy = joysticks[ -9999 ];
-		event.name = EVENT_KEYUP;
+		event.SetId( EVENTID_KEYUP );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.key.keysym.scancode );
@@ -481,7 +481,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		UIEvent( event );
 	} else if ( etype == SDL_TEXTINPUT ) {
 		joy = joysticks[ -9999 ];
-		event.name = EVENT_KEYPRESS;
+		event.SetId( EVENTID_KEYPRESS );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddStringArgument( e.text.text );
@@ -490,14 +490,14 @@ void Input::HandleEvent( SDL_Event& e ) {
 	} /*else if ( etype == SDL_TEXTEDITING ) {
 		joy = joysticks[ -9999 ];
 		printf( "SDL_TEXTEDITING %s\n", e.edit.text );
-		event.name = EVENT_KEYPRESS;
+		event.SetId( EVENTID_KEYPRESS );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddStringArgument( e.text.text );
 		CallEvent( event );
 		UIEvent( event );
 	} */ else if ( etype == SDL_MOUSEBUTTONDOWN ) {
-		event.name = EVENT_MOUSEDOWN;
+		event.SetId( EVENTID_MOUSEDOWN );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.button.button );
@@ -506,7 +506,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		CallEvent( event );
 		UIEvent( event, true );
 	} else if ( etype == SDL_MOUSEBUTTONUP ) {
-		event.name = EVENT_MOUSEUP;
+		event.SetId( EVENTID_MOUSEUP );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.button.button );
@@ -515,7 +515,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		CallEvent( event );
 		UIEvent( event, true );
 	} else if ( etype == SDL_MOUSEMOTION ) {
-		event.name = EVENT_MOUSEMOVE;
+		event.SetId( EVENTID_MOUSEMOVE );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddFloatArgument( ( e.motion.x - app.backScreenDstRect.x ) * app.backscreenScale );
@@ -525,7 +525,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		CallEvent( event );
 		UIEvent( event, true );
 	} else if ( etype == SDL_MOUSEWHEEL ) {
-		event.name = EVENT_MOUSEWHEEL;
+		event.SetId( EVENTID_MOUSEWHEEL );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddFloatArgument( e.wheel.y * mouseWheelScale );
@@ -539,7 +539,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		joy = new Controller( jck );
 		this->joysticks[ jid ] = joy;
 		// fire event
-		event.name = EVENT_CONTROLLERADDED;
+		event.SetId( EVENTID_CONTROLLERADDED );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddObjectArgument( joy->scriptObject );
@@ -549,7 +549,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		if ( it == this->joysticks.end() ) return;
 		joy = it->second;
 		this->joysticks.erase( it );
-		event.name = EVENT_CONTROLLERREMOVED;
+		event.SetId( EVENTID_CONTROLLERREMOVED );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddObjectArgument( joy->scriptObject );
@@ -558,7 +558,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		JoystickMap::iterator it = joysticks.find( e.jbutton.which );
 		if ( it == joysticks.end() ) return;
 		joy = it->second;
-		event.name = EVENT_JOYDOWN;
+		event.SetId( EVENTID_JOYDOWN );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.jbutton.button );
@@ -568,7 +568,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		JoystickMap::iterator it = joysticks.find( e.jbutton.which );
 		if ( it == joysticks.end() ) return;
 		joy = it->second;
-		event.name = EVENT_JOYUP;
+		event.SetId( EVENTID_JOYUP );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		event.scriptParams.AddIntArgument( e.jbutton.button );
@@ -578,7 +578,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		JoystickMap::iterator it = joysticks.find( e.jaxis.which );
 		if ( it == joysticks.end() ) return;
 		joy = it->second;
-		event.name = EVENT_JOYAXIS;
+		event.SetId( EVENTID_JOYAXIS );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		Sint16 v = e.jaxis.value;
@@ -591,7 +591,7 @@ void Input::HandleEvent( SDL_Event& e ) {
 		JoystickMap::iterator it = joysticks.find( e.jhat.which );
 		if ( it == joysticks.end() ) return;
 		joy = it->second;
-		event.name = EVENT_JOYHAT;
+		event.SetId( EVENTID_JOYHAT );
 		event.behaviorParam = &e;
 		event.scriptParams.ResizeArguments( 0 );
 		Uint8 v = e.jhat.value;
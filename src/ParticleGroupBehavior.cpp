@@ -27,7 +27,8 @@ ParticleGroupBehavior::ParticleGroupBehavior( ScriptArguments* args ) : Particle
     this->groupDef.userData = NULL;
     
     // create color object
-    colorUpdated = static_cast<ColorCallback>([this](Color* c){ this->UpdateColor(); });
+    shared_ptr<bool> alive = this->_colorOwnerAlive;
+    colorUpdated = static_cast<ColorCallback>([this, alive](Color* c){ if ( *alive ) this->UpdateColor(); });
     Color *clr = new Color( NULL );
     clr->callback = colorUpdated;
     script.SetProperty( "color", ArgValue( clr->scriptObject ), this->scriptObject );
@@ -46,6 +47,9 @@ ParticleGroupBehavior::ParticleGroupBehavior() : BodyBehavior::BodyBehavior() {}
 // destroy
 ParticleGroupBehavior::~ParticleGroupBehavior() {
     
+    // color can outlive this behavior
+    *this->_colorOwnerAlive = false;
+    
     // remove self from particle system groups
     if ( this->particleSystem ) this->SetSystem( NULL );
         
@@ -121,7 +125,7 @@ void ParticleGroupBehavior::InitClass() {
         if ( val.type == TypeObject ) {
             // replace if it's a color
             Color* other = script.GetInstance<Color>( val.value.objectValue );
-            if ( other ) pg->color = other;
+            Color::Replace( pg->color, other );
         } else {
             pg->color->Set( val );
         }
@@ -429,24 +433,35 @@ bool ParticleGroupBehavior::UseBodyTransform() {
 
 /// copies body transform to game object
 /// only valid for rigid groups
-void ParticleGroupBehavior::SyncObjectToBody() {
+void ParticleGroupBehavior::SyncObjectToBody( float alpha ) {
     
     if ( !(this->group && this->live && (this->groupDef.groupFlags & b2_rigidParticleGroup ) ) ) return;
     
-    b2Vec2 pos = this->group->GetCenter() * BOX2D_TO_WORLD_SCALE;
-    float angle = this->group->GetAngle() * RAD_TO_DEG;
+    b2Vec2 pos = this->group->GetCenter();
+    float angle = this->group->GetAngle();
+    
+    // interpolate from previous step
+    if ( alpha < 1 ) {
+        pos = this->previousCenter + alpha * ( pos - this->previousCenter );
+        angle = this->previousAngle + alpha * ( angle - this->previousAngle );
+    }
+    pos *= BOX2D_TO_WORLD_SCALE;
+    angle *= RAD_TO_DEG;
     
     // construct world transform matrix for object
-    GPU_MatrixIdentity( this->gameObject->_worldTransform );
-    GPU_MatrixTranslate( this->gameObject->_worldTransform, pos.x, pos.y, this->gameObject->_z );
-    if ( angle != 0 ) GPU_MatrixRotate( this->gameObject->_worldTransform, angle, 0, 0, 1 );
-    if ( this->gameObject->_scale.x != 1 || this->gameObject->_scale.y != 1 ) GPU_MatrixScale( this->gameObject->_worldTransform, this->gameObject->_scale.x, this->gameObject->_scale.y, 1 );
-    if ( this->gameObject->_skew.x != 1 || this->gameObject->_skew.y != 1 ) MatrixSkew( this->gameObject->_worldTransform, this->gameObject->_skew.x, this->gameObject->_skew.y );
-    this->gameObject->_worldTransformDirty = false;
+    this->gameObject->_worldTransform.Compose( pos.x, pos.y, this->gameObject->_z, angle, this->gameObject->_scale.x, this->gameObject->_scale.y, this->gameObject->_skew.x, this->gameObject->_skew.y );
+    this->gameObject->WorldTransformUpdated();
     this->gameObject->_localCoordsAreDirty = this->gameObject->_inverseWorldDirty = this->gameObject->_transformDirty = true;
 
 }
 
+/// stores current group transform as previous step's
+void ParticleGroupBehavior::SavePreviousTransform() {
+    if ( !this->group ) return;
+    this->previousCenter = this->group->GetCenter();
+    this->previousAngle = this->group->GetAngle();
+}
+
 /// converts game object's local transform to body
 /// only valid for rigid groups
 void ParticleGroupBehavior::SyncBodyToObject() {
@@ -455,8 +470,8 @@ void ParticleGroupBehavior::SyncBodyToObject() {
     this->gameObject->body = NULL;
     
     // parent's world transform times local transform = this object world transform
-    if ( this->gameObject->parent ) GPU_MatrixMultiply( this->gameObject->_worldTransform, this->gameObject->parent->WorldTransform(), this->gameObject->Transform() );
-    this->gameObject->_worldTransformDirty = false;
+    if ( this->gameObject->parent ) Affine2D::Multiply( this->gameObject->_worldTransform, this->gameObject->parent->WorldTransform(), this->gameObject->Transform() );
+    this->gameObject->WorldTransformUpdated();
     
     // relink
     this->gameObject->body = this;
@@ -499,6 +514,7 @@ void ParticleGroupBehavior::SetBodyTransform( b2Vec2 newPos, float angleInRad )
         }
         this->group->m_transform.Set( newPos, angleInRad );
         this->group->m_center = newPos;
+        this->SavePreviousTransform();
     }
 }
 
@@ -515,6 +531,7 @@ void ParticleGroupBehavior::SetBodyPosition( b2Vec2 newPos ) {
     }
     this->group->m_transform.Set( newPos, this->group->GetAngle() );
     this->group->m_center = newPos;
+    this->SavePreviousTransform();
 }
 
 /// set body angle
@@ -540,6 +557,7 @@ void ParticleGroupBehavior::SetBodyAngle( float angleInRad ) {
         velocities[ i ] = pos;
     }
     this->group->m_transform.Set( center, angleInRad );
+    this->SavePreviousTransform();
 }
 
 // gets body transform
@@ -680,6 +698,7 @@ void ParticleGroupBehavior::AddBody( Scene *scene ) {
     
     // self
     this->group->SetUserData( this );
+    this->SavePreviousTransform();
     
     // make live
     this->live = true;
@@ -40,6 +40,9 @@ public:
     Color* color = NULL;
     ColorCallback colorUpdated;
     
+    /// captured by color callback, cleared in destructor ( script can hold on to color after behavior is gone )
+    shared_ptr<bool> _colorOwnerAlive = make_shared<bool>( true );
+    
     // functions update live particles or stored points
     void UpdateColor();
     void UpdateFlags();
@@ -73,8 +76,15 @@ public:
     /// turns on and off ( active switch )
     void EnableBody( bool e );
     
-    /// called after physics step on each body to sync position and rotation
-    void SyncObjectToBody();
+    /// called after physics step on each body to sync position and rotation, alpha < 1 interpolates from previous step
+    void SyncObjectToBody( float alpha=1 );
+    
+    /// rigid group center and angle before last physics step, in box2d units
+    b2Vec2 previousCenter = { 0, 0 };
+    float previousAngle = 0;
+    
+    /// stores current group transform as previous step's, for interpolation
+    void SavePreviousTransform();
     
     /// call to sync body to manually set object position
     void SyncBodyToObject();
@@ -409,13 +409,23 @@ void ParticleSystem::RemoveFromWorld() {
     }
 }
 
-void ParticleSystem::SyncObjectsToGroups() {
+void ParticleSystem::SyncObjectsToGroups( float alpha ) {
  
     unordered_set<ParticleGroupBehavior*>::iterator it = this->groups.begin(), end = this->groups.end();
     while( it != end ) {
         ParticleGroupBehavior* pg = *it;
         //if ( pg->group && pg->live && ( pg->groupDef.groupFlags & b2_rigidParticleGroup ) )
-        pg->SyncObjectToBody();
+        pg->SyncObjectToBody( alpha );
+        it++;
+    }
+    
+}
+
+void ParticleSystem::SavePreviousGroupTransforms() {
+    
+    unordered_set<ParticleGroupBehavior*>::iterator it = this->groups.begin(), end = this->groups.end();
+    while( it != end ) {
+        (*it)->SavePreviousTransform();
         it++;
     }
     
@@ -32,7 +32,8 @@ public:
     
     void AddToWorld();
     void RemoveFromWorld();
-    void SyncObjectsToGroups();
+    void SyncObjectsToGroups( float alpha=1 );
+    void SavePreviousGroupTransforms();
     
     // garbage collector
     void TraceProtectedObjects( vector<void**> &protectedObjects );
@@ -4,6 +4,10 @@
 
 // static
 RenderBehavior::ShaderVariant RenderBehavior::shaders[ SHADER_MAXVAL ];
+RenderBehavior::SpriteBatch RenderBehavior::spriteBatch;
+bool RenderBehavior::batchSprites = true;
+list<size_t> RenderBehavior::shaderWarmUpQueue;
+bool RenderBehavior::shaderCacheEnabled = true;
 
 
 /* MARK:	-				Init / destroy
@@ -19,18 +23,31 @@ RenderBehavior::RenderBehavior() {
 /// called by child classes to add default objects
 void RenderBehavior::AddDefaults() {
 	
+	// changing color components changes render
+	shared_ptr<bool> alive = this->_colorsOwnerAlive;
+	colorChanged = [this, alive]( Color* c ){
+		if ( *alive && this->gameObject ) this->gameObject->RenderChanged();
+	};
+	
 	// create color object
 	Color *color = new Color( NULL );
+	color->callback = colorChanged;
 	script.SetProperty( "color", ArgValue( color->scriptObject ), this->scriptObject );
 	
 	// create addColor object
 	color = new Color( NULL );
 	color->SetInts( 0, 0, 0, 0 );
+	color->callback = colorChanged;
 	script.SetProperty( "addColor", ArgValue( color->scriptObject ), this->scriptObject );
 		
 }
 
-RenderBehavior::~RenderBehavior() {}
+RenderBehavior::~RenderBehavior() {
+	
+	// colors can outlive this behavior, their callbacks become no-ops ( colors themselves may already be finalized )
+	*this->_colorsOwnerAlive = false;
+	
+}
 
 
 /* MARK:	-				UI
@@ -52,6 +69,11 @@ bool RenderBehavior::IsScreenPointInside( float x, float y, float* outLocalX, fl
 
 bool RenderBehavior::ClipsMouseEventsFor( GameObject* c ) { return false; }
 
+/// any native property (size, pivot, shape params) can change bounds
+void RenderBehavior::NativePropertyChanged() {
+	if ( this->gameObject ) this->gameObject->InvalidateBounds();
+}
+
 /* MARK:	-				Script
  -------------------------------------------------------------------- */
 
@@ -90,7 +112,7 @@ void RenderBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->color = other;
+			Color::Replace( rs->color, other );
 		} else {
 			rs->color->Set( val );
 		}
@@ -105,7 +127,7 @@ void RenderBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->addColor = other;
+			Color::Replace( rs->addColor, other );
 		} else {
 			rs->addColor->Set( val );
 		}
@@ -161,6 +183,10 @@ void RenderBehavior::_UpdateBlendTarget( GPU_Target *targ, GPU_Target **blendTar
 	
 	if ( targ && targ->image && blendTarg ) {
 		
+		// area of target to copy, w < 0 = whole target
+		GPU_Rect captureRect = { 0, 0, -1, -1 };
+		this->_GetBlendCaptureRect( targ, captureRect );
+		
 		// create new if none avail
 		if ( !*blendTarg ) {
 			GPU_Image* img = GPU_CreateImage( targ->base_w, targ->base_h, targ->image->format );
@@ -188,10 +214,15 @@ void RenderBehavior::_UpdateBlendTarget( GPU_Target *targ, GPU_Target **blendTar
 			GPU_MatrixMode( GPU_MODELVIEW );
 			GPU_PushMatrix();
 			GPU_MatrixIdentity( GPU_GetCurrentMatrix() );
-			// draw target
+			// draw target ( only the part under this render )
             GPU_DeactivateShaderProgram(); // GPU_ActivateShaderProgram( 0, NULL );
 			GPU_Rect srcRect = { 0, 0, (float) targ->base_w, (float) targ->base_h };
-			GPU_Blit( targ->image, &srcRect, *blendTarg, 0, 0 );
+			if ( captureRect.w > 0 && captureRect.h > 0 ) {
+				srcRect = captureRect;
+				GPU_BlitRect( targ->image, &srcRect, *blendTarg, &srcRect );
+			} else if ( captureRect.w < 0 ) {
+				GPU_Blit( targ->image, &srcRect, *blendTarg, 0, 0 );
+			}
 			// pop
 			GPU_MatrixMode( GPU_MODELVIEW );
 			GPU_PopMatrix();
@@ -202,6 +233,55 @@ void RenderBehavior::_UpdateBlendTarget( GPU_Target *targ, GPU_Target **blendTar
 	}
 }
 
+/// computes area of target this render will cover, in target image pixels ( same as gl_FragCoord the blend shader samples background at ).
+/// Leaves rect.w < 0 if the whole target needs to be copied.
+void RenderBehavior::_GetBlendCaptureRect( GPU_Target* targ, GPU_Rect& rect ) {
+	
+	// refract samples background away from drawn area
+	GPU_Rect bounds;
+	if ( this->blendMode == BlendMode::Refract || !this->GetCullBounds( bounds ) ) return;
+	
+	// padded
+	float pad = this->texturePad + 1;
+	bounds.x -= pad; bounds.y -= pad;
+	bounds.w += pad * 2; bounds.h += pad * 2;
+	GPU_Rect projected;
+	if ( RenderBehavior::ProjectRect( bounds, targ, projected ) ) rect = projected;
+}
+
+/// projects bounds through current projection and modelview into whole pixels of targ's image, clipped to targ. Returns false if it can't be projected.
+bool RenderBehavior::ProjectRect( const GPU_Rect& bounds, GPU_Target* targ, GPU_Rect& rect ) {
+	
+	// corners to clip space
+	float mvp[ 16 ];
+	GPU_MatrixMultiply( mvp, GPU_GetProjection(), GPU_GetModelView() );
+	float xs[ 2 ] = { bounds.x, bounds.x + bounds.w };
+	float ys[ 2 ] = { bounds.y, bounds.y + bounds.h };
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	for ( int i = 0; i < 4; i++ ) {
+		float x = xs[ i & 1 ], y = ys[ i >> 1 ];
+		float w = mvp[ 3 ] * x + mvp[ 7 ] * y + mvp[ 15 ];
+		if ( w <= 0 ) return false;
+		float cx = ( mvp[ 0 ] * x + mvp[ 4 ] * y + mvp[ 12 ] ) / w;
+		float cy = ( mvp[ 1 ] * x + mvp[ 5 ] * y + mvp[ 13 ] ) / w;
+		
+		// viewport
+		cx = ( cx + 1 ) * 0.5f * targ->w;
+		cy = ( cy + 1 ) * 0.5f * targ->h;
+		minX = fmin( minX, cx ); maxX = fmax( maxX, cx );
+		minY = fmin( minY, cy ); maxY = fmax( maxY, cy );
+	}
+	
+	// clip to target, whole pixels
+	minX = fmax( 0, floor( minX ) ); minY = fmax( 0, floor( minY ) );
+	maxX = fmin( targ->w, ceil( maxX ) ); maxY = fmin( targ->h, ceil( maxY ) );
+	rect.x = minX;
+	rect.y = minY;
+	rect.w = fmax( 0, maxX - minX );
+	rect.h = fmax( 0, maxY - minY );
+	return true;
+}
+
 size_t RenderBehavior::SelectTexturedShader(
 		float tw, float th,
 		float u, float v, float w, float h,
@@ -211,6 +291,9 @@ size_t RenderBehavior::SelectTexturedShader(
         float ox, float oy,
 		GPU_Image *image, GPU_Target* targ, GPU_Target** blendTarg ){
 
+	// draw pending sprites first
+	FlushSpriteBatch();
+	
 	size_t shaderIndex = SHADER_TEXTURE;
 	
 	if ( this->stipple != 0 || this->stippleAlpha ) shaderIndex |= SHADER_STIPPLE;
@@ -344,6 +427,9 @@ size_t RenderBehavior::SelectTexturedShader(
 
 size_t RenderBehavior::SelectUntexturedShader( GPU_Target* targ, GPU_Target** blendTarg ) {
 	
+	// draw pending sprites first
+	FlushSpriteBatch();
+	
 	size_t shaderIndex = 0;
 	
 	if ( this->stipple != 0 || this->stippleAlpha ) shaderIndex |= SHADER_STIPPLE;
@@ -395,76 +481,148 @@ size_t RenderBehavior::SelectUntexturedShader( GPU_Target* targ, GPU_Target** bl
  
 	return shaderIndex;
 	
-<<<<<<< HEAD
 }
 
-void RenderBehavior::SelectBasicShader(GPU_Image* image) {
-    
-    // activate
-    // GPU_ActivateShaderProgram( mainShader.shader, &mainShader.shaderBlock );
+/* MARK:	-				Sprite batch
+ -------------------------------------------------------------------- */
 
-    // set params
-    float params[ 4 ];
-    
-    // addColor
-    params[ 0 ] = params[ 1 ] = params[ 2 ] = params[ 3 ] = 0;
-    GPU_SetUniformfv( mainShader.addColorUniform, 4, 1, params );
-    
-    // stipple
-    GPU_SetUniformi( mainShader.stippleUniform, 0 );
-    GPU_SetUniformi( mainShader.stippleAlphaUniform, 0 );
-    
-    if ( image ) {
-        
-        params[ 1 ] = params[ 0 ] = 1.0;
-        GPU_SetUniformfv( mainShader.tileUniform, 2, 1, params );
-        
-        // thresh
-        GPU_SetUniformf( mainShader.alphaThreshUniform, 0 );
-        
-        // pad
-        GPU_SetUniformf( mainShader.texPadUniform, 0 );
-        
-        // texture size
-        params[ 0 ] = image->base_w;
-        params[ 1 ] = image->base_h;
-        GPU_SetUniformfv( mainShader.texSizeUniform, 2, 1, params );
-        
-        // sprite on texture
-        params[ 0 ] = 0;
-        params[ 1 ] = 0;
-        params[ 2 ] = image->base_w;
-        params[ 3 ] = image->base_h;
-        GPU_SetUniformfv( mainShader.texInfoUniform, 4, 1, params );
-        
-        // slicing
-        params[ 0 ] = params[ 1 ] = params[ 2 ] = params[ 3 ] = 0;
-        GPU_SetUniformfv( mainShader.sliceUniform, 4, 1, params );
-        
-        // slicing: sprite scaling
-        params[ 0 ] = params[ 1 ] = 1;
-        GPU_SetUniformfv( mainShader.sliceScaleUniform, 2, 1, params );
-        
-        // scroll
-        params[ 0 ] = params[ 1 ] = 0;
-        GPU_SetUniformfv( mainShader.scrollOffsetUniform, 2, 1, params );
-        
-    } else {
-        
-        params[ 1 ] = params[ 0 ] = 0.0;
-        GPU_SetUniformfv( mainShader.tileUniform, 2, 1, params );
 
-    }
-    
-    // blend mode
-    GPU_SetUniformi( mainShader.blendUniform, 0 );
-    
-    // outline params
-    params[ 0 ] = params[ 1 ] = params[ 2 ] = 0;
-    GPU_SetUniformfv( mainShader.outlineOffsetRadiusUniform, 3, 1, params );
-    
-=======
->>>>>>> parent of 5e63b91... wip optimisation
+/// true if this renderer's effects can all be expressed by batch shader variant
+bool RenderBehavior::CanBatch() {
+	return batchSprites &&
+		this->stipple == 0 && !this->stippleAlpha &&
+		( this->blendMode == BlendMode::Normal || this->blendMode == BlendMode::Cut ) &&
+		this->outlineRadius == 0 && this->outlineOffsetX == 0 && this->outlineOffsetY == 0 &&
+		this->texturePad == 0 && this->alphaThresh == 0;
+}
+
+/// adds quad to sprite batch, params match GPU_BlitRectX with pivot at dest origin + SelectTexturedShader
+void RenderBehavior::BatchSprite( GPU_Image* image, GPU_Target* target, GPU_Rect& srcRect, GPU_Rect& dest, float degrees, SDL_Color color,
+								  float u, float v, float w, float h, float tx, float ty, float ox, float oy ) {
+	
+	SpriteBatch &batch = spriteBatch;
+	float *p = GPU_GetProjection();
+	
+	// state changed - draw pending
+	if ( batch.numSprites &&
+		( batch.image != image || batch.target != target || batch.blendMode != this->blendMode ||
+		  batch.numSprites >= SPRITE_BATCH_MAX_SPRITES ||
+		  memcmp( batch.projection, p, sizeof( batch.projection ) ) != 0 ) ) {
+		FlushSpriteBatch();
+	}
+	
+	// start new batch
+	if ( !batch.numSprites ) {
+		batch.image = image;
+		batch.target = target;
+		batch.blendMode = this->blendMode;
+		memcpy( batch.projection, p, sizeof( batch.projection ) );
+	}
+	
+	// quad corners, rotated around dest origin, then transformed by current modelview
+	static const float cornerX[ 4 ] = { 0, 1, 1, 0 };
+	static const float cornerY[ 4 ] = { 0, 0, 1, 1 };
+	float *mv = GPU_GetModelView();
+	float rad = degrees * DEG_TO_RAD;
+	float cosA = cos( rad ), sinA = sin( rad );
+	float texW = image->texture_w, texH = image->texture_h;
+	float addR = this->addColor->r, addG = this->addColor->g, addB = this->addColor->b, addA = this->addColor->a;
+	unsigned short firstVertex = (unsigned short) ( batch.numSprites * 4 );
+	for ( int i = 0; i < 4; i++ ) {
+		float lx = cornerX[ i ] * dest.w, ly = cornerY[ i ] * dest.h;
+		float x = dest.x + lx * cosA - ly * sinA;
+		float y = dest.y + lx * sinA + ly * cosA;
+		float vertex[ SPRITE_BATCH_VERTEX_FLOATS ] = {
+			mv[ 0 ] * x + mv[ 4 ] * y + mv[ 12 ],
+			mv[ 1 ] * x + mv[ 5 ] * y + mv[ 13 ],
+			( srcRect.x + cornerX[ i ] * srcRect.w ) / texW,
+			( srcRect.y + cornerY[ i ] * srcRect.h ) / texH,
+			color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f
+		};
+		float attribs[ SPRITE_BATCH_ATTRIB_FLOATS ] = {
+			addR, addG, addB, addA,
+			u, v, w, h,
+			tx, ty, ox, oy
+		};
+		batch.vertices.insert( batch.vertices.end(), vertex, vertex + SPRITE_BATCH_VERTEX_FLOATS );
+		batch.attributes.insert( batch.attributes.end(), attribs, attribs + SPRITE_BATCH_ATTRIB_FLOATS );
+	}
+	unsigned short quad[ 6 ] = {
+		firstVertex, (unsigned short) ( firstVertex + 1 ), (unsigned short) ( firstVertex + 2 ),
+		firstVertex, (unsigned short) ( firstVertex + 2 ), (unsigned short) ( firstVertex + 3 ) };
+	batch.indices.insert( batch.indices.end(), quad, quad + 6 );
+	batch.numSprites++;
+	
+}
+
+/// draws and clears pending sprite batch
+void RenderBehavior::FlushSpriteBatch() {
+	
+	SpriteBatch &batch = spriteBatch;
+	if ( !batch.numSprites ) return;
+	
+	// activate batch shader
+	size_t shaderIndex = SHADER_TEXTURE | SHADER_BATCH;
+	ShaderVariant &variant = shaders[ shaderIndex ];
+	if ( !variant.shader ) variant = CompileShaderWithFeatures( shaderIndex );
+	GPU_ActivateShaderProgram( variant.shader, &variant.shaderBlock );
+	
+	// shared params
+	float params[ 2 ] = { (float) batch.image->base_w, (float) batch.image->base_h };
+	if ( variant.texSizeUniform >= 0 ) GPU_SetUniformfv( variant.texSizeUniform, 2, 1, params );
+	if ( variant.texPadUniform >= 0 ) GPU_SetUniformf( variant.texPadUniform, 0 );
+	if ( variant.alphaThreshUniform >= 0 ) GPU_SetUniformf( variant.alphaThreshUniform, 0 );
+	
+	// blend mode
+	if ( batch.blendMode == BlendMode::Cut ) {
+		GPU_SetBlendFunction( batch.image, GPU_FUNC_ZERO, GPU_FUNC_DST_ALPHA, GPU_FUNC_ONE, GPU_FUNC_ONE );
+		GPU_SetBlendEquation( batch.image, GPU_EQ_ADD, GPU_EQ_REVERSE_SUBTRACT);
+	} else {
+		GPU_SetBlendFunction( batch.image, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE_MINUS_SRC_ALPHA, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE );
+		GPU_SetBlendEquation( batch.image, GPU_EQ_ADD, GPU_EQ_ADD);
+	}
+	
+	// per-vertex sprite params
+	int numVertices = (int) batch.numSprites * 4;
+	int stride = SPRITE_BATCH_ATTRIB_FLOATS * sizeof( float );
+	float *attribs = batch.attributes.data();
+	GPU_SetAttributeSource( numVertices, GPU_MakeAttribute( variant.batchAddColorAttribute, attribs, GPU_MakeAttributeFormat( 4, GPU_TYPE_FLOAT, false, stride, 0 ) ) );
+	GPU_SetAttributeSource( numVertices, GPU_MakeAttribute( variant.batchTexInfoAttribute, attribs, GPU_MakeAttributeFormat( 4, GPU_TYPE_FLOAT, false, stride, 4 * sizeof( float ) ) ) );
+	GPU_SetAttributeSource( numVertices, GPU_MakeAttribute( variant.batchTileScrollAttribute, attribs, GPU_MakeAttributeFormat( 4, GPU_TYPE_FLOAT, false, stride, 8 * sizeof( float ) ) ) );
+	
+	// vertices already have modelview applied, use projection from when batch was started
+	GPU_MatrixMode( GPU_PROJECTION );
+	GPU_PushMatrix();
+	GPU_MatrixCopy( GPU_GetProjection(), batch.projection );
+	GPU_MatrixMode( GPU_MODELVIEW );
+	GPU_PushMatrix();
+	GPU_MatrixIdentity( GPU_GetModelView() );
+	
+	// draw
+	GPU_TriangleBatchX( batch.image, batch.target, (unsigned short) numVertices, batch.vertices.data(),
+					   (unsigned int) batch.indices.size(), batch.indices.data(), GPU_BATCH_XY_ST_RGBA );
+	
+	// restore
+	GPU_MatrixMode( GPU_MODELVIEW );
+	GPU_PopMatrix();
+	GPU_MatrixMode( GPU_PROJECTION );
+	GPU_PopMatrix();
+	GPU_MatrixMode( GPU_MODELVIEW );
+	
+	// detach attribute sources
+	GPU_AttributeFormat noFormat = GPU_MakeAttributeFormat( 4, GPU_TYPE_FLOAT, false, 0, 0 );
+	GPU_SetAttributeSource( 0, GPU_MakeAttribute( variant.batchAddColorAttribute, NULL, noFormat ) );
+	GPU_SetAttributeSource( 0, GPU_MakeAttribute( variant.batchTexInfoAttribute, NULL, noFormat ) );
+	GPU_SetAttributeSource( 0, GPU_MakeAttribute( variant.batchTileScrollAttribute, NULL, noFormat ) );
+	
+	// clear
+	batch.vertices.clear();
+	batch.attributes.clear();
+	batch.indices.clear();
+	batch.numSprites = 0;
+	batch.image = NULL;
+	batch.target = NULL;
+	
 }
 
 // compiles shader with features
@@ -483,15 +641,40 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 	string vertParams;
 	string vertFeatures;
 	
+	// batched sprites receive per-sprite params as vertex attributes, passed on to fragment shader
+	bool batch = ( featuresMask & SHADER_BATCH );
+	string fragIn = glsles ? "varying " : "in ";
+	string addColorParam = batch ? ( fragIn + "vec4 addColor;" ) : "uniform vec4 addColor;";
+	if ( batch ) {
+		string vertIn = glsles ? "attribute " : "in ";
+		string vertOut = glsles ? "varying " : "out ";
+		vertParams +=
+		vertIn + "vec4 batchAddColor;\n" +
+		vertIn + "vec4 batchTexInfo;\n" +
+		vertIn + "vec4 batchTileScroll;\n" +
+		vertOut + "vec4 addColor;\n" +
+		vertOut + "vec4 texInfo;\n" +
+		vertOut + "vec2 tile;\n" +
+		vertOut + "vec2 scrollOffset;\n";
+		vertFeatures +=
+		"addColor = batchAddColor;\n\
+		texInfo = batchTexInfo;\n\
+		tile = batchTileScroll.xy;\n\
+		scrollOffset = batchTileScroll.zw;\n";
+	}
+	
 	// has texture
 	if ( featuresMask & SHADER_TEXTURE ) {
 		params +=
 		"uniform sampler2D tex;\n\
-		uniform vec2 texSize;\n\
-		uniform vec4 texInfo;\n\
+		uniform vec2 texSize;\n";
+		params += batch ?
+		( fragIn + "vec4 texInfo;\n" + fragIn + "vec2 scrollOffset;\n" + fragIn + "vec2 tile;\n" ) :
+		"uniform vec4 texInfo;\n\
         uniform vec2 scrollOffset;\n\
-        uniform vec2 tile;\n\
-        uniform float alphaThresh;\n\
+        uniform vec2 tile;\n";
+		params +=
+        "uniform float alphaThresh;\n\
 		uniform float texPad;";
 		funcs =
 		"vec4 readPixel( sampler2D _tex, vec2 uv ){\n\
@@ -736,7 +919,7 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
         precision mediump float;\n\
 		varying mediump vec4 color;\n\
 		varying vec2 texCoord;\n\
-		uniform vec4 addColor;\n\
+		%s\n\
 		%s\n\
 		%s\n\
 		void main(void){\n\
@@ -744,7 +927,7 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 			vec2 coord = texCoord;\n\
 			%s\n\
 			gl_FragColor = src;\n\
-		}", renderer->min_shader_version, params.c_str(), funcs.c_str(), features.c_str() );
+		}", renderer->min_shader_version, addColorParam.c_str(), params.c_str(), funcs.c_str(), features.c_str() );
 	} else {
 		sprintf ( vertShader,
 		"#version %d\n\
@@ -768,7 +951,7 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 		in vec4 color;\n\
 		in vec2 texCoord;\n\
 		in vec4 gl_FragCoord;\n\
-		uniform vec4 addColor;\n\
+		%s\n\
 		out vec4 fragColor;\n\
 		%s\n\
 		%s\n\
@@ -777,34 +960,20 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 			vec2 coord = texCoord;\n\
 			%s\n\
 			fragColor = src;\n\
-		}", renderer->min_shader_version, params.c_str(), funcs.c_str(), features.c_str() );
+		}", renderer->min_shader_version, addColorParam.c_str(), params.c_str(), funcs.c_str(), features.c_str() );
 
 	}
 		
-<<<<<<< HEAD
-	// compile
-	if ( CompileShader( mainShader.shader, mainShader.shaderBlock, vertShader, fragShader ) ) {
-        mainShader.scrollOffsetUniform = GPU_GetUniformLocation( mainShader.shader, "scrollOffset" );
-        mainShader.backgroundUniform = GPU_GetUniformLocation( mainShader.shader, "background" );
-        mainShader.backgroundSizeUniform = GPU_GetUniformLocation( mainShader.shader, "backgroundSize" );
-		mainShader.addColorUniform = GPU_GetUniformLocation( mainShader.shader, "addColor" );
-		mainShader.tileUniform = GPU_GetUniformLocation( mainShader.shader, "tile" );
-		mainShader.texInfoUniform = GPU_GetUniformLocation( mainShader.shader, "texInfo" );
-		mainShader.texSizeUniform = GPU_GetUniformLocation( mainShader.shader, "texSize" );
-		mainShader.texPadUniform = GPU_GetUniformLocation( mainShader.shader, "texPad" );
-        mainShader.sliceUniform = GPU_GetUniformLocation( mainShader.shader, "slice" );
-		mainShader.sliceScaleUniform = GPU_GetUniformLocation( mainShader.shader, "sliceScale" );
-		mainShader.stippleUniform = GPU_GetUniformLocation( mainShader.shader, "stipple" );
-		mainShader.stippleAlphaUniform = GPU_GetUniformLocation( mainShader.shader, "stippleAlpha" );
-		mainShader.blendUniform = GPU_GetUniformLocation( mainShader.shader, "blendMode" );
-		mainShader.outlineColorUniform = GPU_GetUniformLocation( mainShader.shader, "outlineColor" );
-		mainShader.outlineOffsetRadiusUniform = GPU_GetUniformLocation( mainShader.shader, "outlineOffsetRadius" );
-        mainShader.alphaThreshUniform = GPU_GetUniformLocation( mainShader.shader, "alphaThresh" );
-        printf( "Main shader compiled.\n" );
-=======
-	// compile variant
+	// compile variant, or load it from cache
 	ShaderVariant& variant = shaders[ featuresMask ];
-	if ( CompileShader( variant.shader, variant.shaderBlock, vertShader, fragShader ) ) {
+	size_t sourceHash = HashString( vertShader ) * 31 + HashString( fragShader );
+	bool loaded = LoadCachedShader( variant.shader, featuresMask, sourceHash );
+	if ( loaded ) {
+		variant.shaderBlock = GPU_LoadShaderBlock( variant.shader, "gpu_Vertex", "gpu_TexCoord", "gpu_Color", "gpu_ModelViewProjectionMatrix" );
+	} else if ( ( loaded = CompileShader( variant.shader, variant.shaderBlock, vertShader, fragShader ) ) ) {
+		SaveCachedShader( variant.shader, featuresMask, sourceHash );
+	}
+	if ( loaded ) {
         variant.scrollOffsetUniform = GPU_GetUniformLocation( variant.shader, "scrollOffset" );
         variant.backgroundUniform = GPU_GetUniformLocation( variant.shader, "background" );
         variant.backgroundSizeUniform = GPU_GetUniformLocation( variant.shader, "backgroundSize" );
@@ -821,7 +990,9 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 		variant.outlineColorUniform = GPU_GetUniformLocation( variant.shader, "outlineColor" );
 		variant.outlineOffsetRadiusUniform = GPU_GetUniformLocation( variant.shader, "outlineOffsetRadius" );
         variant.alphaThreshUniform = GPU_GetUniformLocation( variant.shader, "alphaThresh" );
->>>>>>> parent of 5e63b91... wip optimisation
+		variant.batchAddColorAttribute = GPU_GetAttributeLocation( variant.shader, "batchAddColor" );
+		variant.batchTexInfoAttribute = GPU_GetAttributeLocation( variant.shader, "batchTexInfo" );
+		variant.batchTileScrollAttribute = GPU_GetAttributeLocation( variant.shader, "batchTileScroll" );
 	} else {
 		printf ( "Shader error: %s\nin shaders[%zu]:\n%s\n%s\n", GPU_GetShaderMessage(), featuresMask, fragShader, vertShader );
 		exit(1);
@@ -831,6 +1002,165 @@ RenderBehavior::ShaderVariant& RenderBehavior::CompileShaderWithFeatures( size_t
 	
 }
 
+/* MARK:	-				Shader warm-up and cache
+ -------------------------------------------------------------------- */
+
+
+/// queues shader variants to compile ahead of first use ( see ProcessShaderWarmUp )
+void RenderBehavior::WarmUpShaders( const size_t* featureMasks, size_t count ) {
+	for ( size_t i = 0; i < count; i++ ) {
+		if ( featureMasks[ i ] < SHADER_MAXVAL ) shaderWarmUpQueue.push_back( featureMasks[ i ] );
+	}
+}
+
+/// compiles queued variants until budget milliseconds are spent ( at least one per call ), called each frame
+void RenderBehavior::ProcessShaderWarmUp( Uint32 budget ) {
+	Uint32 start = SDL_GetTicks();
+	while ( shaderWarmUpQueue.size() ) {
+		size_t mask = shaderWarmUpQueue.front();
+		shaderWarmUpQueue.pop_front();
+		if ( shaders[ mask ].shader ) continue;
+		CompileShaderWithFeatures( mask );
+		if ( SDL_GetTicks() - start >= budget ) break;
+	}
+}
+
+// GL entry points for program binaries ( GL_OES_get_program_binary / GL_ARB_get_program_binary ), looked up at runtime
+#define SHADER_CACHE_GL_RENDERER				0x1F01
+#define SHADER_CACHE_GL_VERSION					0x1F02
+#define SHADER_CACHE_GL_LINK_STATUS				0x8B82
+#define SHADER_CACHE_GL_PROGRAM_BINARY_LENGTH	0x8741
+#define SHADER_CACHE_MAGIC						0x48535641 // "AVSH"
+
+typedef struct {
+	bool initialized;
+	bool supported;
+	string directory;
+	size_t rendererHash;
+	void (*getProgramBinary)( Uint32 program, int bufSize, int* length, Uint32* binaryFormat, void* binary );
+	void (*programBinary)( Uint32 program, Uint32 binaryFormat, const void* binary, int length );
+	void (*getProgramiv)( Uint32 program, Uint32 pname, int* params );
+	Uint32 (*createProgram)();
+	void (*deleteProgram)( Uint32 program );
+} ShaderBinaryCache;
+
+typedef struct {
+	Uint32 magic;
+	Uint32 binaryFormat;
+	Uint64 rendererHash;
+	Uint64 sourceHash;
+	Sint32 length;
+} ShaderCacheHeader;
+
+static ShaderBinaryCache shaderBinaryCache = { false, false };
+
+/// looks up GL functions, and cache directory
+static ShaderBinaryCache& GetShaderBinaryCache() {
+	ShaderBinaryCache& c = shaderBinaryCache;
+	if ( c.initialized ) return c;
+	c.initialized = true;
+	
+	// extension
+	const char* suffix = NULL;
+	if ( SDL_GL_ExtensionSupported( "GL_OES_get_program_binary" ) ) suffix = "OES";
+	else if ( SDL_GL_ExtensionSupported( "GL_ARB_get_program_binary" ) ) suffix = "";
+	if ( !suffix ) return c;
+	
+	// functions
+	c.getProgramBinary = (void (*)( Uint32, int, int*, Uint32*, void* )) SDL_GL_GetProcAddress( ( string( "glGetProgramBinary" ) + suffix ).c_str() );
+	c.programBinary = (void (*)( Uint32, Uint32, const void*, int )) SDL_GL_GetProcAddress( ( string( "glProgramBinary" ) + suffix ).c_str() );
+	c.getProgramiv = (void (*)( Uint32, Uint32, int* )) SDL_GL_GetProcAddress( "glGetProgramiv" );
+	c.createProgram = (Uint32 (*)()) SDL_GL_GetProcAddress( "glCreateProgram" );
+	c.deleteProgram = (void (*)( Uint32 )) SDL_GL_GetProcAddress( "glDeleteProgram" );
+	const unsigned char* (*getString)( Uint32 ) = (const unsigned char* (*)( Uint32 )) SDL_GL_GetProcAddress( "glGetString" );
+	if ( !c.getProgramBinary || !c.programBinary || !c.getProgramiv || !c.createProgram || !c.deleteProgram || !getString ) return c;
+	
+	// binaries are only valid for the same driver
+	const char* glRenderer = (const char*) getString( SHADER_CACHE_GL_RENDERER );
+	const char* glVersion = (const char*) getString( SHADER_CACHE_GL_VERSION );
+	c.rendererHash = HashString( glRenderer ? glRenderer : "" ) * 31 + HashString( glVersion ? glVersion : "" );
+	
+	// writable directory
+	char* prefPath = SDL_GetPrefPath( "Aviko", "shaders" );
+	if ( !prefPath ) return c;
+	c.directory = prefPath;
+	SDL_free( prefPath );
+	c.supported = true;
+	return c;
+}
+
+/// loads linked program from disk cache, returns false if not cached or driver doesn't support program binaries
+bool RenderBehavior::LoadCachedShader( Uint32& outShader, size_t featuresMask, size_t sourceHash ) {
+	if ( !shaderCacheEnabled ) return false;
+	ShaderBinaryCache& c = GetShaderBinaryCache();
+	if ( !c.supported ) return false;
+	
+	// read file
+	static char filename[ 64 ];
+	sprintf( filename, "variant%zu.bin", featuresMask );
+	FILE* f = fopen( ( c.directory + filename ).c_str(), "rb" );
+	if ( !f ) return false;
+	ShaderCacheHeader header;
+	bool ok = fread( &header, sizeof( header ), 1, f ) == 1 &&
+			  header.magic == SHADER_CACHE_MAGIC && header.rendererHash == (Uint64) c.rendererHash &&
+			  header.sourceHash == (Uint64) sourceHash && header.length > 0;
+	void* binary = NULL;
+	if ( ok ) {
+		binary = malloc( header.length );
+		ok = fread( binary, header.length, 1, f ) == 1;
+	}
+	fclose( f );
+	
+	// create program
+	if ( ok ) {
+		Uint32 program = c.createProgram();
+		int status = 0;
+		c.programBinary( program, header.binaryFormat, binary, header.length );
+		c.getProgramiv( program, SHADER_CACHE_GL_LINK_STATUS, &status );
+		if ( status ) {
+			outShader = program;
+		} else {
+			c.deleteProgram( program );
+			ok = false;
+		}
+	}
+	if ( binary ) free( binary );
+	return ok;
+}
+
+/// saves linked program to disk cache, if driver supports program binaries
+void RenderBehavior::SaveCachedShader( Uint32 shader, size_t featuresMask, size_t sourceHash ) {
+	if ( !shaderCacheEnabled ) return;
+	ShaderBinaryCache& c = GetShaderBinaryCache();
+	if ( !c.supported ) return;
+	
+	// get binary
+	int length = 0;
+	c.getProgramiv( shader, SHADER_CACHE_GL_PROGRAM_BINARY_LENGTH, &length );
+	if ( length <= 0 ) return;
+	ShaderCacheHeader header;
+	memset( &header, 0, sizeof( header ) );
+	header.magic = SHADER_CACHE_MAGIC;
+	header.rendererHash = (Uint64) c.rendererHash;
+	header.sourceHash = (Uint64) sourceHash;
+	void* binary = malloc( length );
+	c.getProgramBinary( shader, length, &header.length, &header.binaryFormat, binary );
+	
+	// write file
+	if ( header.length > 0 ) {
+		static char filename[ 64 ];
+		sprintf( filename, "variant%zu.bin", featuresMask );
+		string path = c.directory + filename;
+		FILE* f = fopen( path.c_str(), "wb" );
+		if ( f ) {
+			bool ok = fwrite( &header, sizeof( header ), 1, f ) == 1 && fwrite( binary, header.length, 1, f ) == 1;
+			fclose( f );
+			if ( !ok ) remove( path.c_str() );
+		}
+	}
+	free( binary );
+}
+
 /// helper method
 bool RenderBehavior::CompileShader( Uint32& outShader, GPU_ShaderBlock& outShaderBlock, const char* vertShader, const char* fragShader ){
 	
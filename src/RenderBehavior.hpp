@@ -13,7 +13,13 @@
 #define SHADER_STIPPLE	0x10
 #define SHADER_OUTLINE	0x20
 #define SHADER_PARTICLE 0x40
-#define SHADER_MAXVAL	0x80
+#define SHADER_BATCH	0x80
+#define SHADER_MAXVAL	0x100
+
+// sprite batch limits
+#define SPRITE_BATCH_MAX_SPRITES	2048
+#define SPRITE_BATCH_VERTEX_FLOATS	8 // x, y, s, t, r, g, b, a
+#define SPRITE_BATCH_ATTRIB_FLOATS	12 // addColor, texInfo, tile + scrollOffset
 
 class RigidBodyShape;
 class RenderSpriteBehavior;
@@ -35,6 +41,12 @@ public:
 	/// returns true if screen space point is inside this GameObject/RenderBehavior
 	virtual bool IsScreenPointInside( float x, float y, float* outLocalX, float* outLocalY );
 	
+	/// (overriden in child classes) returns local-space bounds used for culling, or false if they can't be determined
+	virtual bool GetCullBounds( GPU_Rect& bounds ){ return false; }
+	
+	/// native property changes can affect bounds
+	void NativePropertyChanged();
+	
 	/// UIs without layout handler will call this on gameObject's render component
 	virtual void Resize( float w, float h ) {};
 	
@@ -45,6 +57,12 @@ public:
 	Color *color = NULL;
 	Color *addColor = NULL;
 	
+	/// callback on color objects, changing color components changes render
+	ColorCallback colorChanged;
+	
+	/// captured by color callbacks, cleared in destructor ( script can hold on to colors after behavior is gone )
+	shared_ptr<bool> _colorsOwnerAlive = make_shared<bool>( true );
+	
 	// rendering pivot / offset ( range 0.0 - 1.0 )
 	float pivotX = 0;
 	float pivotY = 0;
@@ -124,6 +142,9 @@ public:
 		int outlineColorUniform;
 		int outlineOffsetRadiusUniform;
         int alphaThreshUniform;
+		int batchAddColorAttribute; // per-vertex addColor (batch variant)
+		int batchTexInfoAttribute; // per-vertex texInfo (batch variant)
+		int batchTileScrollAttribute; // per-vertex tile + scrollOffset (batch variant)
 	} ShaderVariant;
 
 	/// shader permutations
@@ -132,6 +153,12 @@ public:
 	/// draws target to blendTarget
 	void _UpdateBlendTarget( GPU_Target* targ, GPU_Target** blendTarg );
 	
+	/// computes area of target covered by this render for _UpdateBlendTarget, leaves rect.w < 0 if unknown
+	void _GetBlendCaptureRect( GPU_Target* targ, GPU_Rect& rect );
+	
+	/// projects bounds through current projection and modelview to pixel rect on targ's image, clipped to targ. Returns false if can't project.
+	static bool ProjectRect( const GPU_Rect& bounds, GPU_Target* targ, GPU_Rect& rect );
+	
 	/// applies current shader + params
 	size_t SelectTexturedShader(
 					 float tw = 0, float th = 0,
@@ -153,6 +180,54 @@ public:
 
 	/// helper method for shader compilation
 	static bool CompileShader( Uint32& outShader, GPU_ShaderBlock& outShaderBlock, const char* vertShader, const char* fragShader );
+	
+	/// variants waiting to be compiled ahead of first use
+	static list<size_t> shaderWarmUpQueue;
+	
+	/// queues shader variants to compile ahead of first use ( see ProcessShaderWarmUp )
+	static void WarmUpShaders( const size_t* featureMasks, size_t count );
+	
+	/// compiles queued variants until budget milliseconds are spent ( at least one per call ), called each frame
+	static void ProcessShaderWarmUp( Uint32 budget );
+	
+	/// set to false to always compile shaders, instead of loading program binaries cached on disk
+	static bool shaderCacheEnabled;
+	
+	/// loads linked program from disk cache, returns false if not cached or driver doesn't support program binaries
+	static bool LoadCachedShader( Uint32& outShader, size_t featuresMask, size_t sourceHash );
+	
+	/// saves linked program to disk cache, if driver supports program binaries
+	static void SaveCachedShader( Uint32 shader, size_t featuresMask, size_t sourceHash );
+	
+// sprite batch
+	
+	/// textured quads waiting to be drawn with a single call, vertices are pre-multiplied by modelview
+	typedef struct {
+		GPU_Image* image = NULL;
+		GPU_Target* target = NULL;
+		BlendMode blendMode = BlendMode::Normal;
+		float projection[ 16 ];
+		vector<float> vertices;
+		vector<float> attributes;
+		vector<unsigned short> indices;
+		size_t numSprites = 0;
+	} SpriteBatch;
+	
+	/// pending batch
+	static SpriteBatch spriteBatch;
+	
+	/// when false, each sprite activates its own shader and draws immediately
+	static bool batchSprites;
+	
+	/// true if this renderer's effects can all be expressed by batch shader variant
+	bool CanBatch();
+	
+	/// adds quad to sprite batch, flushing pending quads first if image, target, blend mode or projection differ
+	void BatchSprite( GPU_Image* image, GPU_Target* target, GPU_Rect& srcRect, GPU_Rect& dest, float degrees, SDL_Color color,
+					  float u, float v, float w, float h, float tx, float ty, float ox, float oy );
+	
+	/// draws and clears pending sprite batch
+	static void FlushSpriteBatch();
 
 // shape from render
 	
@@ -3,6 +3,9 @@
 
 GPU_Image* RenderParticlesBehavior::surface = NULL;
 ImageResource* RenderParticlesBehavior::particleTexture = NULL;
+vector<float> RenderParticlesBehavior::batchVertices;
+vector<unsigned short> RenderParticlesBehavior::batchIndices;
+vector<b2ParticleGroup*> RenderParticlesBehavior::renderGroups;
 
 /* MARK:    -                Init / destroy
  -------------------------------------------------------------------- */
@@ -20,6 +23,7 @@ RenderParticlesBehavior::RenderParticlesBehavior( ScriptArguments* args ) : Rend
     // create effect color object
     Color* color = new Color( NULL );
     color->SetInts( 0, 0, 0, 255 );
+    color->callback = colorChanged;
     script.SetProperty( "outlineColor", ArgValue( color->scriptObject ), this->scriptObject );
 
     // anything above this alpha val is drawn as solid
@@ -119,6 +123,11 @@ void RenderParticlesBehavior::InitClass() {
         return ( ps->velocityStretchFactor = fmax( 0, val ) );
     } ) );
     
+    script.AddProperty<RenderParticlesBehavior>
+    ( "includeChildren",
+     static_cast<ScriptBoolCallback>([](void *b, bool val ){ return ((RenderParticlesBehavior*) b)->includeChildren; }),
+     static_cast<ScriptBoolCallback>([](void *b, bool val ){ return ( ((RenderParticlesBehavior*) b)->includeChildren = val ); }) );
+    
     script.AddProperty<RenderParticlesBehavior>
     ( "fadeTime",
      static_cast<ScriptFloatCallback>([](void *b, float val ){ return ((RenderParticlesBehavior*) b)->fadeTime; }),
@@ -183,7 +192,7 @@ void RenderParticlesBehavior::InitClass() {
         if ( val.type == TypeObject ) {
             // replace if it's a color
             Color* other = script.GetInstance<Color>( val.value.objectValue );
-            if ( other ) rs->outlineColor = other;
+            Color::Replace( rs->outlineColor, other );
         } else {
             rs->outlineColor->Set( val );
         }
@@ -247,8 +256,16 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
         behavior->particles = script.GetInstance<ParticleGroupBehavior>( behavior->gameObject->body->scriptObject );
     }
     
+    // groups to draw
+    RenderParticlesBehavior::renderGroups.clear();
+    if ( behavior->particles && behavior->particles->group ) RenderParticlesBehavior::renderGroups.push_back( behavior->particles->group );
+    if ( behavior->includeChildren ) RenderParticlesBehavior::CollectChildGroups( behavior->gameObject );
+    
     // no particles? bail
-    if ( !behavior->particles || !behavior->particles->group ) return;
+    if ( RenderParticlesBehavior::renderGroups.empty() ) return;
+    
+    // particles move every frame
+    behavior->gameObject->RenderChanged();
     
     // get/check color
     SDL_Color color = behavior->color->rgba;
@@ -283,8 +300,8 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
     float shaderU = 0, shaderV = 0, shaderW = 0, shaderH = 0; // bounds of texture slice
     float shaderTileX = 1, shaderTileY = 1;
 
-    // texture
-    if ( behavior->imageResource ) {
+    // texture ( default particle while loading )
+    if ( behavior->imageResource && !behavior->imageResource->IsLoading() ) {
         
         image = behavior->imageResource->mainResource ?
         behavior->imageResource->mainResource->image :
@@ -313,14 +330,6 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
         
     }
 
-    // clear surface
-    GPU_ClearRGBA( RenderParticlesBehavior::surface->target, 0, 0, 0, 0 );
-    
-    // activate shader
-    behavior->SelectParticleShader(shaderU, shaderV, shaderW, shaderH,
-                                   shaderTileX, shaderTileY, rotated,
-                                   image, RenderParticlesBehavior::surface->target );
-    
     // push view matrix
     GPU_MatrixMode( GPU_MODELVIEW );
     GPU_PushMatrix();
@@ -330,76 +339,164 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
     // if rendering to image / clipped
     if ( event->clippedBy ) {
         // apply inverse of container's world transform
-        GPU_MatrixCopy( GPU_GetCurrentMatrix(), event->clippedBy->gameObject->InverseWorld() );
+        event->clippedBy->gameObject->InverseWorld().ToMatrix( GPU_GetCurrentMatrix() );
     }
     
-    // set up to go over each particle
-    b2ParticleSystem* ps = behavior->particles->group->GetParticleSystem();
-    b2ParticleGroup* group = behavior->particles->group;
-    int32 i = group->GetBufferIndex(), last = i + group->GetParticleCount();
-    b2Vec2 *positions = ps->GetPositionBuffer();
-    b2ParticleColor* colors = ps->GetColorBuffer();
-    b2Vec2* velocities = ps->GetVelocityBuffer();
-    float radius = ps->GetRadius() * BOX2D_TO_WORLD_SCALE;
-    float baseScale = ( 2 * radius + behavior->extents + ( 1 - behavior->alphaThresh ) * RenderParticlesBehavior::particleTexture->image->base_w )
-                       / (float) RenderParticlesBehavior::particleTexture->image->base_w;
-    float rotation = 0, lifeTime = 0, vel = 0;
-    float velStretch = 0, velStretchSquared = WORLD_TO_BOX2D_SCALE * behavior->velocityStretch * behavior->velocityStretch;
-    bool doFade = ( behavior->fadeTime > 0 );
-    float sx = 1, sy = 1;
-    
-    // for each particle
-    for ( ; i < last; i++ ) {
-        
-        // color
-        b2ParticleColor &pclr = colors[ i ];
-        RenderParticlesBehavior::particleTexture->image->color.r = pclr.r * behavior->color->r;
-        RenderParticlesBehavior::particleTexture->image->color.g = pclr.g * behavior->color->g;
-        RenderParticlesBehavior::particleTexture->image->color.b = pclr.b * behavior->color->b;
-        RenderParticlesBehavior::particleTexture->image->color.a = pclr.a * behavior->color->a;
-        
-        // rotation
-        rotation = atan2( velocities[ i ].y, velocities[ i ].x );
-        
-        // velocity
-        vel = velocities[ i ].LengthSquared();
-        if ( vel > 0 ) {
-            velStretch = vel / velStretchSquared;
-            sx = baseScale * ( 1 + behavior->velocityStretchFactor * fmin( 1.0, velStretch ) );
-            sy = baseScale * ( 1 - 0.6 * behavior->velocityStretchFactor * fmin( 1.0, velStretch ) );
-        } else {
-            sx = sy = baseScale;
+    // shared particle quad
+    GPU_Image* particleImage = RenderParticlesBehavior::particleTexture->image;
+    GPU_Rect &particleRect = RenderParticlesBehavior::particleTexture->frame.locationOnTexture;
+    float halfW = particleRect.w * particleImage->anchor_x, halfH = particleRect.h * particleImage->anchor_y;
+    float left = -halfW, top = -halfH, right = particleRect.w - halfW, bottom = particleRect.h - halfH;
+    float stretchX = behavior->velocityStretchFactor, stretchY = 0.6 * behavior->velocityStretchFactor;
+    
+    // world bounds of all groups, padded by largest ( stretched ) particle quad
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    float quadRadius = sqrtf( fmax( left * left, right * right ) + fmax( top * top, bottom * bottom ) ) * ( 1 + stretchX );
+    for ( size_t g = 0, ng = RenderParticlesBehavior::renderGroups.size(); g < ng; g++ ) {
+        b2ParticleGroup* group = RenderParticlesBehavior::renderGroups[ g ];
+        b2ParticleSystem* ps = group->GetParticleSystem();
+        b2Vec2 *positions = ps->GetPositionBuffer();
+        float gMinX = FLT_MAX, gMinY = FLT_MAX, gMaxX = -FLT_MAX, gMaxY = -FLT_MAX;
+        for ( int32 i = group->GetBufferIndex(), last = i + group->GetParticleCount(); i < last; i++ ) {
+            gMinX = fmin( gMinX, positions[ i ].x ); gMaxX = fmax( gMaxX, positions[ i ].x );
+            gMinY = fmin( gMinY, positions[ i ].y ); gMaxY = fmax( gMaxY, positions[ i ].y );
         }
+        if ( gMinX > gMaxX ) continue;
+        float radius = ps->GetRadius() * BOX2D_TO_WORLD_SCALE;
+        float pad = quadRadius * ( 2 * radius + behavior->extents + ( 1 - behavior->alphaThresh ) * particleImage->base_w ) / (float) particleImage->base_w;
+        minX = fmin( minX, gMinX * BOX2D_TO_WORLD_SCALE - pad ); maxX = fmax( maxX, gMaxX * BOX2D_TO_WORLD_SCALE + pad );
+        minY = fmin( minY, gMinY * BOX2D_TO_WORLD_SCALE - pad ); maxY = fmax( maxY, gMaxY * BOX2D_TO_WORLD_SCALE + pad );
+    }
+    
+    // area of surface / target to draw, composite shader samples around it for outline
+    GPU_Rect drawRect = { 0, 0, 0, 0 }, clearRect;
+    GPU_Rect bounds = { minX, minY, maxX - minX, maxY - minY };
+    if ( minX <= maxX && !RenderBehavior::ProjectRect( bounds, RenderParticlesBehavior::surface->target, drawRect ) ) {
+        drawRect = RenderParticlesBehavior::surface->target->viewport;
+    }
+    
+    // nothing on screen
+    if ( drawRect.w <= 0 || drawRect.h <= 0 ) {
+        GPU_PopMatrix();
+        return;
+    }
+    float outlinePad = ceil( fabs( behavior->outlineRadius ) + fmax( fabs( behavior->outlineOffsetX ), fabs( behavior->outlineOffsetY ) ) ) + 1;
+    drawRect.x = fmax( 0, drawRect.x - outlinePad ); drawRect.y = fmax( 0, drawRect.y - outlinePad );
+    drawRect.w = fmin( RenderParticlesBehavior::surface->base_w - drawRect.x, drawRect.w + outlinePad * 2 );
+    drawRect.h = fmin( RenderParticlesBehavior::surface->base_h - drawRect.y, drawRect.h + outlinePad * 2 );
+    clearRect.x = fmax( 0, drawRect.x - outlinePad ); clearRect.y = fmax( 0, drawRect.y - outlinePad );
+    clearRect.w = fmin( RenderParticlesBehavior::surface->base_w - clearRect.x, drawRect.w + outlinePad * 2 );
+    clearRect.h = fmin( RenderParticlesBehavior::surface->base_h - clearRect.y, drawRect.h + outlinePad * 2 );
 
-        // lifetime
-        lifeTime = ps->GetParticleLifetime( i );
-        if ( doFade && lifeTime > 0 && lifeTime <= behavior->fadeTime ) {
-            float fade = lifeTime / behavior->fadeTime;
-            sx *= fade; sy *= fade;
+    
+    // clear only the used part of surface
+    GPU_SetClipRect( RenderParticlesBehavior::surface->target, clearRect );
+    GPU_ClearRGBA( RenderParticlesBehavior::surface->target, 0, 0, 0, 0 );
+    
+    // activate shader
+    behavior->SelectParticleShader(shaderU, shaderV, shaderW, shaderH,
+                                   shaderTileX, shaderTileY, rotated,
+                                   image, RenderParticlesBehavior::surface->target );
+    
+    // set up to go over each particle
+    float velStretchSquared = WORLD_TO_BOX2D_SCALE * behavior->velocityStretch * behavior->velocityStretch;
+    float fadeTime = behavior->fadeTime;
+    bool doFade = ( fadeTime > 0 );
+    float s0 = particleRect.x / particleImage->texture_w, t0 = particleRect.y / particleImage->texture_h;
+    float s1 = ( particleRect.x + particleRect.w ) / particleImage->texture_w, t1 = ( particleRect.y + particleRect.h ) / particleImage->texture_h;
+    float tintR = behavior->color->r, tintG = behavior->color->g, tintB = behavior->color->b, tintA = behavior->color->a;
+    
+    // index buffer is the same for every batch
+    if ( RenderParticlesBehavior::batchIndices.empty() ) {
+        RenderParticlesBehavior::batchIndices.resize( PARTICLE_BATCH_MAX_PARTICLES * 6 );
+        unsigned short* idx = RenderParticlesBehavior::batchIndices.data();
+        for ( unsigned short q = 0, v = 0; q < PARTICLE_BATCH_MAX_PARTICLES; q++, v += 4, idx += 6 ) {
+            idx[ 0 ] = v; idx[ 1 ] = v + 1; idx[ 2 ] = v + 2;
+            idx[ 3 ] = v; idx[ 4 ] = v + 2; idx[ 5 ] = v + 3;
         }
-                
-        // apply transform
-        GPU_PushMatrix();
-        GPU_Translate( positions[ i ].x * BOX2D_TO_WORLD_SCALE, positions[ i ].y * BOX2D_TO_WORLD_SCALE, 0 );
-        GPU_Rotate( RAD_TO_DEG * rotation, 0, 0, 1 );
-        GPU_Scale( sx, sy, 1 );
-
-        // draw
-        GPU_Blit(RenderParticlesBehavior::particleTexture->image,
-                 &RenderParticlesBehavior::particleTexture->frame.locationOnTexture,
-                 RenderParticlesBehavior::surface->target, 0, 0 );
-        
-        // pop transform
-        GPU_PopMatrix();
-        
+    }
+    
+    // each group into the same surface
+    for ( size_t g = 0, ng = RenderParticlesBehavior::renderGroups.size(); g < ng; g++ ) {
         
-        /*GPU_BlitTransformX(RenderParticlesBehavior::particleTexture->image, NULL, RenderParticlesBehavior::surface->target,
-                           positions[ i ].x * BOX2D_TO_WORLD_SCALE, positions[ i ].y * BOX2D_TO_WORLD_SCALE,
-                           16, 16,
-                           RAD_TO_DEG * rotation,
-                           sx, sy );*/
+        b2ParticleGroup* group = RenderParticlesBehavior::renderGroups[ g ];
+        b2ParticleSystem* ps = group->GetParticleSystem();
+        int32 first = group->GetBufferIndex(), count = group->GetParticleCount();
+        if ( !count ) continue;
+        b2Vec2 *positions = ps->GetPositionBuffer();
+        b2ParticleColor* colors = ps->GetColorBuffer();
+        b2Vec2* velocities = ps->GetVelocityBuffer();
+        const int32* expirationTimes = doFade ? ps->GetExpirationTimeBuffer() : NULL;
+        float radius = ps->GetRadius() * BOX2D_TO_WORLD_SCALE;
+        float baseScale = ( 2 * radius + behavior->extents + ( 1 - behavior->alphaThresh ) * particleImage->base_w )
+                           / (float) particleImage->base_w;
+        RenderParticlesBehavior::batchVertices.resize( max( RenderParticlesBehavior::batchVertices.size(),
+                                                            (size_t) min( count, PARTICLE_BATCH_MAX_PARTICLES ) * 4 * PARTICLE_BATCH_VERTEX_FLOATS ) );
         
+        // in chunks that fit into one batch
+        for ( int32 start = first, last = first + count; start < last; start += PARTICLE_BATCH_MAX_PARTICLES ) {
+            
+            int32 end = min( last, start + PARTICLE_BATCH_MAX_PARTICLES );
+            float* vert = RenderParticlesBehavior::batchVertices.data();
+            
+            // for each particle
+            for ( int32 i = start; i < end; i++, vert += 4 * PARTICLE_BATCH_VERTEX_FLOATS ) {
+                
+                // color
+                b2ParticleColor &pclr = colors[ i ];
+                float r = (Uint8) ( pclr.r * tintR ) / 255.0f, g = (Uint8) ( pclr.g * tintG ) / 255.0f,
+                      b = (Uint8) ( pclr.b * tintB ) / 255.0f, a = (Uint8) ( pclr.a * tintA ) / 255.0f;
+                
+                // rotation from velocity direction, and stretch
+                float vx = velocities[ i ].x, vy = velocities[ i ].y;
+                float vel = vx * vx + vy * vy;
+                float sx = baseScale, sy = baseScale, cosA = 1, sinA = 0;
+                if ( vel > 0 ) {
+                    float velStretch = fmin( 1.0f, vel / velStretchSquared );
+                    float invLength = 1.0f / sqrtf( vel );
+                    cosA = vx * invLength;
+                    sinA = vy * invLength;
+                    sx *= ( 1 + stretchX * velStretch );
+                    sy *= ( 1 - stretchY * velStretch );
+                }
+                
+                // lifetime
+                if ( doFade ) {
+                    float lifeTime = ps->ExpirationTimeToLifetime( expirationTimes[ i ] );
+                    if ( lifeTime > 0 && lifeTime <= fadeTime ) {
+                        float fade = lifeTime / fadeTime;
+                        sx *= fade; sy *= fade;
+                    }
+                }
+                
+                // scaled, rotated axes
+                float ax = cosA * sx, ay = sinA * sx, bx = -sinA * sy, by = cosA * sy;
+                float px = positions[ i ].x * BOX2D_TO_WORLD_SCALE, py = positions[ i ].y * BOX2D_TO_WORLD_SCALE;
+                
+                // corners
+                float* v = vert;
+                v[ 0 ] = px + ax * left + bx * top; v[ 1 ] = py + ay * left + by * top;
+                v[ 2 ] = s0; v[ 3 ] = t0; v[ 4 ] = r; v[ 5 ] = g; v[ 6 ] = b; v[ 7 ] = a;
+                v += PARTICLE_BATCH_VERTEX_FLOATS;
+                v[ 0 ] = px + ax * right + bx * top; v[ 1 ] = py + ay * right + by * top;
+                v[ 2 ] = s1; v[ 3 ] = t0; v[ 4 ] = r; v[ 5 ] = g; v[ 6 ] = b; v[ 7 ] = a;
+                v += PARTICLE_BATCH_VERTEX_FLOATS;
+                v[ 0 ] = px + ax * right + bx * bottom; v[ 1 ] = py + ay * right + by * bottom;
+                v[ 2 ] = s1; v[ 3 ] = t1; v[ 4 ] = r; v[ 5 ] = g; v[ 6 ] = b; v[ 7 ] = a;
+                v += PARTICLE_BATCH_VERTEX_FLOATS;
+                v[ 0 ] = px + ax * left + bx * bottom; v[ 1 ] = py + ay * left + by * bottom;
+                v[ 2 ] = s0; v[ 3 ] = t1; v[ 4 ] = r; v[ 5 ] = g; v[ 6 ] = b; v[ 7 ] = a;
+            }
+            
+            // draw chunk
+            int32 numParticles = end - start;
+            GPU_TriangleBatch( particleImage, RenderParticlesBehavior::surface->target,
+                               (unsigned short) ( numParticles * 4 ), RenderParticlesBehavior::batchVertices.data(),
+                               (unsigned int) ( numParticles * 6 ), RenderParticlesBehavior::batchIndices.data(),
+                               GPU_BATCH_XY_ST_RGBA );
+        }
     }
+    GPU_UnsetClip( RenderParticlesBehavior::surface->target );
 
     // pop modelview
     GPU_PopMatrix();
@@ -438,8 +535,8 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
     RenderParticlesBehavior::surface->color = behavior->color->rgba;
     RenderParticlesBehavior::surface->color.a *= behavior->gameObject->combinedOpacity;
     
-    // draw
-    GPU_BlitRect( RenderParticlesBehavior::surface, &RenderParticlesBehavior::surface->target->viewport, target, &RenderParticlesBehavior::surface->target->viewport );
+    // draw only the part with particles
+    GPU_BlitRect( RenderParticlesBehavior::surface, &drawRect, target, &drawRect );
 
     // pop modelview and projection
     GPU_PopMatrix();
@@ -447,6 +544,17 @@ void RenderParticlesBehavior::Render( RenderParticlesBehavior* behavior, GPU_Tar
     GPU_PopMatrix();
 }
 
+/// adds particle groups of descendants without their own renderer to renderGroups
+void RenderParticlesBehavior::CollectChildGroups( GameObject* go ) {
+    for ( size_t i = 0, nc = go->children.size(); i < nc; i++ ) {
+        GameObject* child = go->children[ i ];
+        if ( !child->active() || child->render ) continue;
+        ParticleGroupBehavior* pg = child->body ? script.GetInstance<ParticleGroupBehavior>( child->body->scriptObject ) : NULL;
+        if ( pg && pg->group ) RenderParticlesBehavior::renderGroups.push_back( pg->group );
+        RenderParticlesBehavior::CollectChildGroups( child );
+    }
+}
+
 size_t RenderParticlesBehavior::SelectParticleShader(float u, float v, float w, float h,
                                                      float tx, float ty, bool rotated,
                                                      GPU_Image *image, GPU_Target* targ ){
@@ -6,6 +6,12 @@
 #include "ParticleGroupBehavior.hpp"
 #include "ImageResource.hpp"
 
+/// max particles submitted in one triangle batch ( 4 vertices each, indexed by unsigned short )
+#define PARTICLE_BATCH_MAX_PARTICLES 16383
+
+/// floats per particle batch vertex ( x, y, s, t, r, g, b, a )
+#define PARTICLE_BATCH_VERTEX_FLOATS 8
+
 class RenderParticlesBehavior: public RenderBehavior {
 public:
     
@@ -18,6 +24,13 @@ public:
     static GPU_Image* surface;
     static ImageResource* particleTexture;
     
+    /// vertex and index buffers shared by all particle groups
+    static vector<float> batchVertices;
+    static vector<unsigned short> batchIndices;
+    
+    /// particle groups drawn in current Render call
+    static vector<b2ParticleGroup*> renderGroups;
+    
     /// texture to fill with
     ImageResource* imageResource = NULL;
     float tileX = 1;
@@ -32,9 +45,15 @@ public:
     // particles
     ParticleGroupBehavior* particles = NULL;
     
+    /// also draw particle groups of descendants that don't have their own renderer, in the same offscreen pass
+    bool includeChildren = false;
+    
     /// render callback
     static void Render( RenderParticlesBehavior* behavior, GPU_Target* target, Event* event );
     
+    /// adds particle groups of descendants without their own renderer to renderGroups
+    static void CollectChildGroups( GameObject* go );
+    
     /// shader select
     virtual size_t SelectParticleShader(float u, float v, float w, float h,
                                         float tx, float ty, bool rotated,
@@ -17,7 +17,10 @@ RenderShapeBehavior::RenderShapeBehavior( ScriptArguments* args ) : RenderShapeB
 	ArgValue dv( "Float" );
 	this->polyPoints->InitWithType( dv );
 	this->polyPoints->lockedType = true;
-	this->polyPoints->callback = static_cast<TypedVectorCallback>([this](TypedVector* fv){ this->_renderPointsDirty = true; });
+	this->polyPoints->callback = static_cast<TypedVectorCallback>([this](TypedVector* fv){
+		this->_renderPointsDirty = true;
+		if ( this->gameObject ) this->gameObject->InvalidateBounds();
+	});
 	
 	// add defaults
 	RenderBehavior::AddDefaults();	
@@ -25,6 +28,7 @@ RenderShapeBehavior::RenderShapeBehavior( ScriptArguments* args ) : RenderShapeB
 	// outline color
 	Color* color = new Color( NULL );
 	color->SetInts( 0, 0, 0, 255 );
+	color->callback = colorChanged;
 	script.SetProperty( "outlineColor", ArgValue( color->scriptObject ), this->scriptObject );
 	
 	// read params
@@ -220,7 +224,7 @@ void RenderShapeBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->outlineColor = other;
+			Color::Replace( rs->outlineColor, other );
 		} else {
 			rs->outlineColor->Set( val );
 		}
@@ -527,10 +531,22 @@ GPU_Rect RenderShapeBehavior::GetBounds() {
 	return rect;
 }
 
+// returns bounds for culling
+bool RenderShapeBehavior::GetCullBounds( GPU_Rect& bounds ) {
+	// chain bounds aren't implemented
+	if ( shapeType == ShapeType::Chain ) return false;
+	bounds = this->GetBounds();
+	float pad = this->lineThickness + this->texturePad + 1;
+	bounds.x -= pad; bounds.y -= pad;
+	bounds.w += pad * 2; bounds.h += pad * 2;
+	return true;
+}
+
 void RenderShapeBehavior::Resize( float w, float h ) {
 	
 	// TODO - better resize for shapes
 	this->x = w; this->y = h;
+	if ( this->gameObject ) this->gameObject->InvalidateBounds();
 	
 }
 
@@ -110,6 +110,7 @@ public:
 	bool IsScreenPointInside( float screenX, float screenY, float* outLocalX, float* outLocalY );
 
 	GPU_Rect GetBounds();
+	bool GetCullBounds( GPU_Rect& bounds );
 	
 	/// UIs without layout handler will call this on gameObject's render component
 	void Resize( float w, float h );
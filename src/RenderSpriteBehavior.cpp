@@ -22,6 +22,7 @@ RenderSpriteBehavior::RenderSpriteBehavior( ScriptArguments* args ) : RenderSpri
 	// create effect color object
 	Color* color = new Color( NULL );
 	color->SetInts( 0, 0, 0, 255 );
+	color->callback = colorChanged;
 	script.SetProperty( "outlineColor", ArgValue( color->scriptObject ), this->scriptObject );
 	
 	// with arguments
@@ -70,6 +71,7 @@ RenderSpriteBehavior::~RenderSpriteBehavior() {
 	
 	// release
 	if ( this->imageResource ) this->imageResource->AdjustUseCount( -1 );
+	this->SetSizePending( false );
 	
 }
 
@@ -96,6 +98,7 @@ void RenderSpriteBehavior::InitClass() {
 	 static_cast<ScriptValueCallback>([](void *b, ArgValue val) {
 		RenderSpriteBehavior* rs = (RenderSpriteBehavior*) b;
 		ImageResource* img = NULL;
+		bool sizePending = false;
 		if ( val.type == TypeString && val.value.stringValue->length()	) {
 			// check if changed
 			if ( img && img->key.compare( val.value.stringValue->c_str() ) == 0 ) return val;
@@ -104,6 +107,7 @@ void RenderSpriteBehavior::InitClass() {
 			if ( img->error == ERROR_NONE ) {
 				rs->width = img->frame.actualWidth;
 				rs->height = img->frame.actualHeight;
+				sizePending = img->IsLoading() && img->frame.actualWidth == 0;
 				img->AdjustUseCount( 1 );
 			} else {
 				img = NULL;
@@ -117,6 +121,7 @@ void RenderSpriteBehavior::InitClass() {
 		
 		// set new
 		rs->imageResource = img;
+		rs->SetSizePending( sizePending );
 		return val;
 	}));
 	
@@ -159,6 +164,7 @@ void RenderSpriteBehavior::InitClass() {
 	 static_cast<ScriptFloatCallback>([](void *b, float val ){
 		RenderSpriteBehavior* rs = (RenderSpriteBehavior*) b;
 		rs->width = val;
+		rs->SetSizePending( false );
 		if ( rs->imageInstance ) {
 			rs->imageInstance->width = val;
 		}
@@ -176,6 +182,7 @@ void RenderSpriteBehavior::InitClass() {
 	 static_cast<ScriptFloatCallback>([](void *b, float val ){
 		RenderSpriteBehavior* rs = (RenderSpriteBehavior*) b;
 		rs->height = val;
+		rs->SetSizePending( false );
 		if ( rs->imageInstance ) {
 			rs->imageInstance->height = val;
 		}
@@ -305,7 +312,7 @@ void RenderSpriteBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->outlineColor = other;
+			Color::Replace( rs->outlineColor, other );
 		} else {
 			rs->outlineColor->Set( val );
 		}
@@ -407,6 +414,26 @@ GPU_Rect RenderSpriteBehavior::GetBounds() {
 	return rect;
 }
 
+// returns bounds for culling
+bool RenderSpriteBehavior::GetCullBounds( GPU_Rect& bounds ) {
+	// image drawing its children controls which children are rendered
+	if ( this->imageInstance && ( this->imageInstance->autoDraw || this->imageInstance->autoMask ) ) return false;
+	bounds = this->GetBounds();
+	// texture padding is in texture pixels, scale it to sprite size
+	float pad = this->texturePad;
+	if ( pad > 0 && this->imageResource ) {
+		ImageFrame *frame = &this->imageResource->frame;
+		if ( frame->actualWidth > 0 && frame->actualHeight > 0 ) {
+			pad *= fmax( 1, fmax( this->width / frame->actualWidth, this->height / frame->actualHeight ) );
+		}
+	} else if ( pad > 0 && this->imageInstance && this->imageInstance->width > 0 && this->imageInstance->height > 0 ) {
+		pad *= fmax( 1, fmax( this->width / this->imageInstance->width, this->height / this->imageInstance->height ) );
+	}
+	bounds.x -= pad; bounds.y -= pad;
+	bounds.w += pad * 2; bounds.h += pad * 2;
+	return true;
+}
+
 void RenderSpriteBehavior::Resize( float w, float h ) {
 	this->width = w;
 	this->height = h;
@@ -414,6 +441,21 @@ void RenderSpriteBehavior::Resize( float w, float h ) {
 		this->imageInstance->width = this->width;
 		this->imageInstance->height = this->height;
 	}
+	if ( this->gameObject ) this->gameObject->InvalidateBounds();
+}
+
+/// sets _sizePending, registering with ImageLoader
+void RenderSpriteBehavior::SetSizePending( bool pending ) {
+	this->_sizePending = pending;
+	if ( pending ) ImageLoader::sizePendingSprites.insert( this );
+	else ImageLoader::sizePendingSprites.erase( this );
+}
+
+/// texture finished loading, applies size if pending
+void RenderSpriteBehavior::TextureLoaded() {
+	if ( !this->_sizePending ) return;
+	this->SetSizePending( false );
+	if ( this->imageResource ) this->Resize( this->imageResource->frame.actualWidth, this->imageResource->frame.actualHeight );
 }
 
 /* MARK:	-				Render
@@ -441,6 +483,12 @@ void RenderSpriteBehavior::Render( RenderSpriteBehavior* behavior, GPU_Target* t
 	// texture
 	if ( behavior->imageResource ) {
 		
+		// nothing to draw until loaded ( keep cached renders redrawing until then )
+		if ( behavior->imageResource->IsLoading() ) {
+			behavior->gameObject->RenderChanged();
+			return;
+		}
+		
 		image = behavior->imageResource->mainResource ?
 					behavior->imageResource->mainResource->image :
 					behavior->imageResource->image;
@@ -587,6 +635,21 @@ void RenderSpriteBehavior::Render( RenderSpriteBehavior* behavior, GPU_Target* t
 		sliceScaleY = behavior->height / srcRect.h;
 	}
 	
+	GPU_Rect dest = {
+		cx, cy,
+		( srcRect.w + behavior->texturePad * 2 ) * sx,
+		( srcRect.h + behavior->texturePad * 2 ) * sy
+	};
+	
+	// texture resource sprites without slicing or effects are drawn together with neighbors sharing texture
+	if ( !sliced && behavior->imageResource && behavior->CanBatch() ) {
+		behavior->BatchSprite( image, target, srcRect, dest, rotated ? -90 : 0, color,
+							   shaderU, shaderV, shaderW, shaderH,
+							   shaderTileX, shaderTileY,
+							   behavior->offsetX, behavior->offsetY );
+		return;
+	}
+	
 	// activate shader
 	behavior->SelectTexturedShader(
 		image->base_w, image->base_h,
@@ -597,12 +660,6 @@ void RenderSpriteBehavior::Render( RenderSpriteBehavior* behavior, GPU_Target* t
         behavior->offsetX, behavior->offsetY,
 	    image, target, (GPU_Target**) event->behaviorParam2 );
 	
-	GPU_Rect dest = {
-		cx, cy,
-		( srcRect.w + behavior->texturePad * 2 ) * sx,
-		( srcRect.h + behavior->texturePad * 2 ) * sy
-	};
-	
 	GPU_BlitRectX( image, &srcRect, target, &dest, rotated ? -90 : 0, 0, 0, GPU_FLIP_NONE );
 	
 }
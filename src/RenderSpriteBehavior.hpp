@@ -28,6 +28,15 @@ public:
 	/// image height from texture frame
 	float height = 0;
 	
+	/// true if texture was still loading when assigned, width and height are set once it loads ( by ImageLoader::ProcessLoaded )
+	bool _sizePending = false;
+	
+	/// sets _sizePending, registering with ImageLoader
+	void SetSizePending( bool pending );
+	
+	/// texture finished loading, applies size if pending
+	void TextureLoaded();
+	
 	/// slice texture
 	GPU_Rect slice = { 0, 0, 0, 0 }; // x, y, w, h -> top, right, bottom, left
 		
@@ -55,6 +64,7 @@ public:
 	void GetLocalBounds( float& x, float& y, float& w, float& h );
 	
 	GPU_Rect GetBounds();
+	bool GetCullBounds( GPU_Rect& bounds );
 	
 	/// UIs without layout handler will call this on gameObject's render component
 	void Resize( float w, float h );
@@ -15,11 +15,16 @@ RenderTextBehavior::RenderTextBehavior( ScriptArguments* args ) : RenderTextBeha
 	// add defaults
 	RenderBehavior::AddDefaults();
 	
-	colorUpdated = static_cast<ColorCallback>([this](Color* c){
+	shared_ptr<bool> alive = this->_colorsOwnerAlive;
+	colorUpdated = static_cast<ColorCallback>([this, alive](Color* c){
+		if ( !*alive ) return;
 		this->_dirty = true;
+		if ( this->gameObject ) this->gameObject->RenderChanged();
 	});
-	colorsUpdated = static_cast<TypedVectorCallback>([this](TypedVector* cv){
+	colorsUpdated = static_cast<TypedVectorCallback>([this, alive](TypedVector* cv){
+		if ( !*alive ) return;
 		this->_dirty = true;
+		if ( this->gameObject ) this->gameObject->RenderChanged();
 	});
 	
 	// create background object
@@ -151,7 +156,7 @@ void RenderTextBehavior::InitClass() {
 		RenderTextBehavior* rs = (RenderTextBehavior*) b;
 		if ( val.type == TypeObject ) { // replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->backgroundColor = other;
+			Color::Replace( rs->backgroundColor, other );
 		} else {
 			rs->backgroundColor->Set( val );
 		}
@@ -167,7 +172,7 @@ void RenderTextBehavior::InitClass() {
 		RenderTextBehavior* rs = (RenderTextBehavior*) b;
 		if ( val.type == TypeObject ) { // replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->textColor = other;
+			Color::Replace( rs->textColor, other );
 		} else {
 			rs->textColor->Set( val );
 		}
@@ -183,7 +188,7 @@ void RenderTextBehavior::InitClass() {
 		RenderTextBehavior* rs = (RenderTextBehavior*) b;
 		if ( val.type == TypeObject ) { // replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->selectionColor = other;
+			Color::Replace( rs->selectionColor, other );
 		} else {
 			rs->selectionColor->Set( val );
 		}
@@ -199,7 +204,7 @@ void RenderTextBehavior::InitClass() {
 		RenderTextBehavior* rs = (RenderTextBehavior*) b;
 		if ( val.type == TypeObject ) { // replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->selectionTextColor = other;
+			Color::Replace( rs->selectionTextColor, other );
 		} else {
 			rs->selectionTextColor->Set( val );
 		}
@@ -336,7 +341,7 @@ void RenderTextBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->outlineColor = other;
+			Color::Replace( rs->outlineColor, other );
 		} else {
 			rs->outlineColor->Set( val );
 		}
@@ -684,7 +689,7 @@ void RenderTextBehavior::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->outlineColor = other;
+			Color::Replace( rs->outlineColor, other );
 		} else {
 			rs->outlineColor->Set( val );
 		}
@@ -798,12 +803,8 @@ void RenderTextBehavior::TraceProtectedObjects( vector<void**> &protectedObjects
  -------------------------------------------------------------------- */
 
 
-/// clears prerendered glyphs on font change
+/// drops references to prerendered glyphs on font change
 void RenderTextBehavior::ClearGlyphs() {
-	this->glyphs[ 0 ].clear();
-	this->glyphs[ 1 ].clear();
-	this->glyphs[ 2 ].clear();
-	this->glyphs[ 3 ].clear();
 	this->lines.clear();
 }
 
@@ -919,10 +920,21 @@ int RenderTextBehavior::GetCaretPositionAt( float localX, float localY ) {
     return -1;
 }
 
+// returns bounds for culling
+bool RenderTextBehavior::GetCullBounds( GPU_Rect& bounds ) {
+	// size isn't known until repaint
+	if ( this->_dirty ) return false;
+	bounds = this->GetBounds();
+	bounds.x -= this->texturePad; bounds.y -= this->texturePad;
+	bounds.w += this->texturePad * 2; bounds.h += this->texturePad * 2;
+	return true;
+}
+
 void RenderTextBehavior::Resize( float w, float h ) {
 	this->width = fmax( 0, w );
 	this->height = fmax( 0, h );
 	this->_dirty = true;
+	if ( this->gameObject ) this->gameObject->InvalidateBounds();
 }
 
 
@@ -930,88 +942,46 @@ void RenderTextBehavior::Resize( float w, float h ) {
  -------------------------------------------------------------------- */
 
 
-RenderTextBehavior::GlyphInfo* RenderTextBehavior::GetGlyph(Uint16 c, bool b, bool i) {
+GlyphInfo* RenderTextBehavior::GetGlyph(Uint16 c, bool b, bool i) {
 	
 	// if there's no such glyph, return placeholder
 	if ( c >= 32 && !TTF_GlyphIsProvided( this->fontResource->font, c ) ) return GetGlyph( '?', b, i );
 
-	// try to find it first
-	size_t style = ( b ? TTF_STYLE_BOLD : 0 ) | ( i ? TTF_STYLE_ITALIC : 0 );
-	unordered_map<Uint16, GlyphInfo>::iterator it = this->glyphs[ style ].find( c );
-	GlyphInfo* gi = ( it == glyphs[ style ].end() ? NULL : &it->second );
-	if ( gi ) return gi;
-	
-	// create in place
-	gi = &this->glyphs[ style ][ c ];
-	
-	// if printable character
-	if ( c >= 32 && TTF_GlyphMetrics( this->fontResource->font, c, &gi->minX, &gi->maxX, &gi->minY, &gi->maxY, &gi->advance ) == 0 ) {
-		// set font and style
-		FontResource* fres = this->fontResource;
-		if ( b && i ) {
-			if ( this->fontBoldItalicResource ) {
-				fres = this->fontBoldItalicResource;
-				TTF_SetFontStyle( fres->font, 0 );
-			} else if ( this->fontBoldResource ) {
-				fres = this->fontBoldResource;
-				TTF_SetFontStyle( fres->font, TTF_STYLE_ITALIC );
-			} else if ( this->fontItalicResource ) {
-				fres = this->fontItalicResource;
-				TTF_SetFontStyle( fres->font, TTF_STYLE_BOLD );
-			} else {
-				TTF_SetFontStyle( fres->font, (int) style );
-			}
-		} else if ( b ) {
-			if ( this->fontBoldResource ) {
-				fres = this->fontBoldResource;
-				TTF_SetFontStyle( fres->font, 0 );
-			} else {
-				TTF_SetFontStyle( fres->font, (int) style );
-			}
-		} else if ( i ) {
-			if ( this->fontItalicResource ) {
-				fres = this->fontItalicResource;
-				TTF_SetFontStyle( fres->font, 0 );
-			} else {
-				TTF_SetFontStyle( fres->font, (int) style );
-			}
-		} else {
-			TTF_SetFontStyle( fres->font, 0 );
+	// pick font, and apply missing styles synthetically
+	int style = ( b ? TTF_STYLE_BOLD : 0 ) | ( i ? TTF_STYLE_ITALIC : 0 );
+	FontResource* fres = this->fontResource;
+	if ( b && i ) {
+		if ( this->fontBoldItalicResource ) {
+			fres = this->fontBoldItalicResource;
+			style = 0;
+		} else if ( this->fontBoldResource ) {
+			fres = this->fontBoldResource;
+			style = TTF_STYLE_ITALIC;
+		} else if ( this->fontItalicResource ) {
+			fres = this->fontItalicResource;
+			style = TTF_STYLE_BOLD;
 		}
-		
-		// ensure min advance
-		gi->maxX += this->outlineWidth * 2;
-		gi->maxY += this->outlineWidth * 2;
-		gi->advance = fmax( gi->advance, gi->maxX - gi->minX );
-		
-		// draw
-		TTF_SetFontOutline( fres->font, this->outlineWidth );
-		TTF_SetFontHinting( fres->font, TTF_HINTING_NORMAL );
-		static SDL_Color white = { 255, 255, 255, 255 };
-		SDL_Surface* ss = NULL;
-		if ( antialias ) {
-			ss = TTF_RenderGlyph_Blended( fres->font, c, white );
-		} else {
-			ss = TTF_RenderGlyph_Solid( fres->font, c, white );
+	} else if ( b ) {
+		if ( this->fontBoldResource ) {
+			fres = this->fontBoldResource;
+			style = 0;
+		}
+	} else if ( i ) {
+		if ( this->fontItalicResource ) {
+			fres = this->fontItalicResource;
+			style = 0;
 		}
-		gi->surface = GPU_CopyImageFromSurface( ss );
-		gi->surface->anchor_x = gi->surface->anchor_y = 0;
-		GPU_UnsetImageVirtualResolution( gi->surface );
-		GPU_SetImageFilter( gi->surface, GPU_FILTER_NEAREST );
-		GPU_SetSnapMode( gi->surface, GPU_SNAP_NONE );
-		GPU_SetBlendFunction( gi->surface, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE_MINUS_SRC_ALPHA, GPU_FUNC_SRC_ALPHA, GPU_FUNC_ONE );
-		GPU_SetBlendEquation( gi->surface, GPU_EQ_ADD, GPU_EQ_ADD);
-		SDL_FreeSurface( ss );
 	}
 	
-	// done
-	return gi;
+	// shared between all texts using this font
+	return fres->GetGlyph( c, style, this->outlineWidth, this->antialias );
 }
 
 /// redraws surface
 void RenderTextBehavior::Repaint( bool justMeasure ) {
 	
 	this->_dirty = ( justMeasure ? this->_dirty : false );
+	if ( this->gameObject ) this->gameObject->InvalidateBounds();
 	
 	// clear old image
 	if ( this->surface && !justMeasure ) {
@@ -1381,7 +1351,7 @@ void RenderTextBehavior::Repaint( bool justMeasure ) {
 					// GPU_SetBlendMode( this->surface, GPU_BLEND_MOD_ALPHA );
 					
 					// draw
-					GPU_Blit( character->glyphInfo->surface, NULL, this->surface->target, rect.x, rect.y );
+					GPU_Blit( character->glyphInfo->surface, &character->glyphInfo->rect, this->surface->target, rect.x, rect.y );
 				}
 				
 				// next character
@@ -6,6 +6,7 @@
 #include "TypedVector.hpp"
 
 class FontResource;
+struct GlyphInfo;
 
 class RenderTextBehavior: public RenderBehavior {
 protected:
@@ -13,19 +14,6 @@ protected:
 	/// needs repaint
 	bool _dirty = false;
 	
-	// a prerendered single glyph
-	struct GlyphInfo {
-		//SDL_Surface* surface = NULL;
-		GPU_Image* surface = NULL;
-		int minX = 0;
-		int minY = 0;
-		int maxX = 0;
-		int maxY = 0;
-		int advance = 0;
-		GlyphInfo(){};
-		~GlyphInfo(){ if ( this->surface ) { GPU_FreeTarget( this->surface->target ); GPU_FreeImage( this->surface ); } /* SDL_FreeSurface( this->surface ); */ };
-	};
-	
 	// single character
 	struct RenderTextCharacter {
 		Uint16 value = 0;
@@ -38,10 +26,7 @@ protected:
 		int pad = 0;
 	};
 	
-	/// prerendered glyphs ( 0 - normal, others, mask of TTF_STYLE_BOLD and TTF_STYLE_ITALIC )
-	unordered_map<Uint16, GlyphInfo> glyphs[ 4 ];
-	
-	/// returns prerendered glyph with style
+	/// returns prerendered glyph with style from shared font resource cache
 	GlyphInfo* GetGlyph( Uint16 c, bool b, bool i );
 	
 	struct RenderTextLine {
@@ -197,7 +182,7 @@ public:
 	/// repaints current text, clears dirty flag
 	void Repaint( bool justMeasure=false );
 	
-	/// destroys prerendered glyphs on font change
+	/// drops references to prerendered glyphs on font change
 	void ClearGlyphs();
 	
     ///
@@ -205,6 +190,7 @@ public:
     
 	/// overridden from RenderBehavior
 	GPU_Rect GetBounds();
+	bool GetCullBounds( GPU_Rect& bounds );
 	
 	/// UIs without layout handler will call this on gameObject's render component
 	void Resize( float w, float h );
@@ -52,6 +52,9 @@ public:
 		return ( !dontUnload && useCount <= 0 );
 	}
 	
+	/// true if other resources point to this one ( it must be released after them )
+	virtual bool HasDependents() { return false; }
+	
     /// loads resource from memory location
     virtual bool LoadFromMemory( void* p, int size ){ return false; }
     
@@ -103,11 +106,35 @@ public:
 	
 	unordered_map<string, RESOURCE_TYPE*> map;
 	
+	/// resources by final path, for FindByPath ( sprite sheet frames share sheet's path )
+	unordered_multimap<string, RESOURCE_TYPE*> pathMap;
+	
+	/// resources by key as passed to Get ( + calling script, for relative keys ), so repeated Get skips ResolveKey
+	unordered_map<string, RESOURCE_TYPE*> keyMemo;
+	
+	/// reused for keyMemo lookups to avoid allocating
+	string memoKey;
+	
 public:
 
 	/// get resource by filename/key
 	RESOURCE_TYPE* Get( const char* ckey, bool incrementUseCount=false ){
 		
+		// relative keys resolve differently depending on calling script
+		this->memoKey.assign( ckey );
+		if ( ckey[ 0 ] == '.' ) {
+			const char* caller = GetCallingScriptFilename();
+			this->memoKey.push_back( '\n' );
+			if ( caller ) this->memoKey.append( caller );
+		}
+		
+		// seen this key before
+		auto mit = this->keyMemo.find( this->memoKey );
+		if ( mit != this->keyMemo.end() ) return mit->second;
+		
+		// remember lookup key ( ResolveKey and constructor can call Get recursively )
+		string lookupKey = this->memoKey;
+		
 		// resolve key
 		string filepath, extension, key;
 		key = RESOURCE_TYPE::ResolveKey( ckey, filepath, extension );
@@ -117,6 +144,7 @@ public:
 		
 		// if loaded return it
 		if ( it != this->map.end() ) {
+			this->keyMemo[ lookupKey ] = it->second;
 			return (RESOURCE_TYPE*) it->second;
 		}
 		
@@ -127,6 +155,8 @@ public:
 		
 		// add to map
 		this->map.insert( make_pair( key, resource ) );
+		this->pathMap.insert( make_pair( resource->path, resource ) );
+		this->keyMemo[ lookupKey ] = resource;
 		
 		// use count
 		if ( incrementUseCount ) resource->AdjustUseCount( 1 );
@@ -141,24 +171,36 @@ public:
 		if ( !fullpath ) return NULL;
 		
 		// find it
-		auto it = this->map.begin();
-		while( it != this->map.end() ) {
-			if ( it->second->path.compare( fullpath ) == 0 ) return it->second;
-			it++;
-		}
+		auto it = this->pathMap.find( fullpath );
+		if ( it != this->pathMap.end() ) return it->second;
 		return NULL;
 	}
 	
-	// unload unused resources
-	void UnloadUnusedResources() {
-		auto it = this->map.begin();
-		while( it != this->map.end() ) {
-			if ( it->second->CanUnload() ) {
-				delete it->second;
-				it = this->map.erase( it );
+	/// unloads up to maxUnloads resources ( all if < 0 ), returns true if there are no more to unload
+	bool UnloadUnusedResources( int maxUnloads=-1 ) {
+		// unloading dependents can make their main resource unloadable, repeat until nothing changes
+		bool removed = true;
+		while ( removed ) {
+			removed = false;
+			auto it = this->map.begin();
+			while( it != this->map.end() ) {
+				if ( it->second->CanUnload() ) {
+					if ( maxUnloads == 0 ) return false;
+					// forget memoized lookups pointing to it
+					if ( this->keyMemo.size() ) this->keyMemo.clear();
+					auto range = this->pathMap.equal_range( it->second->path );
+					for ( auto pit = range.first; pit != range.second; pit++ ) {
+						if ( pit->second == it->second ) { this->pathMap.erase( pit ); break; }
+					}
+					delete it->second;
+					it = this->map.erase( it );
+					maxUnloads--;
+					removed = true;
+				}
+				else it++;
 			}
-			else it++;
 		}
+		return true;
 	}
 	
 	// init
@@ -170,11 +212,17 @@ public:
 		// Since resource manager is a static instance, we're not going to release resources manually.
 		// OS will do it on exit
 		
-		// release all resources
-		for ( auto it = this->map.begin(); it != this->map.end(); ++it ) {
-			// printf( "Unloading %s\n", it->first.c_str() );
-			RESOURCE_TYPE* resource = it->second;
-			delete resource;
+		// release all resources, dependents first
+		while ( this->map.size() ) {
+			size_t count = this->map.size();
+			auto it = this->map.begin();
+			while ( it != this->map.end() ) {
+				// printf( "Unloading %s\n", it->first.c_str() );
+				if ( it->second->HasDependents() ) { it++; continue; }
+				delete it->second;
+				it = this->map.erase( it );
+			}
+			if ( count == this->map.size() ) break;
 		}
 		this->map.clear();
 		
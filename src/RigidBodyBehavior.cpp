@@ -75,6 +75,7 @@ void RigidBodyBehavior::InitClass() {
 		RigidBodyBehavior* rb = (RigidBodyBehavior*)p;
 		rb->bodyType = (b2BodyType) min( b2BodyType::b2_dynamicBody + 1, max( 0, val ) );
 		if ( rb->body ) rb->body->SetType( rb->bodyType );
+		rb->MarkActive();
 		return val;
 	}));
 	
@@ -492,6 +493,7 @@ b2Vec2 RigidBodyBehavior::GetVelocity() {
 void RigidBodyBehavior::SetVelocity( b2Vec2 vel ) {
 	this->velocity = vel * WORLD_TO_BOX2D_SCALE;
 	if ( this->body ) this->body->SetLinearVelocity( this->velocity );
+	this->MarkActive();
 }
 
 float RigidBodyBehavior::GetAngularVelocity() {
@@ -502,18 +504,21 @@ float RigidBodyBehavior::GetAngularVelocity() {
 void RigidBodyBehavior::SetAngularVelocity( float v ) {
 	this->angularVelocity = v;
 	if ( this->body ) this->body->SetAngularVelocity( v * DEG_TO_RAD );
+	this->MarkActive();
 }
 
 void RigidBodyBehavior::Impulse( b2Vec2& impulse, b2Vec2& point ){
 	if ( this->body ) {
 		point *= WORLD_TO_BOX2D_SCALE;
 		this->body->ApplyLinearImpulse( impulse * WORLD_TO_BOX2D_SCALE, this->body->GetWorldPoint( point ), true );
+		this->MarkActive();
 	}
 }
 
 void RigidBodyBehavior::AngularImpulse( float impulse ){
 	if ( this->body ) {
 		this->body->ApplyAngularImpulse( impulse * DEG_TO_RAD, true );
+		this->MarkActive();
 	}
 }
 
@@ -521,6 +526,7 @@ void RigidBodyBehavior::Force( b2Vec2& f, b2Vec2& point ){
     if ( this->body ) {
         point *= WORLD_TO_BOX2D_SCALE;
         this->body->ApplyForce( f * WORLD_TO_BOX2D_SCALE, this->body->GetWorldPoint( point ), true );
+        this->MarkActive();
     }
 }
 
@@ -532,13 +538,20 @@ void RigidBodyBehavior::Force( b2Vec2& f, b2Vec2& point ){
 bool RigidBodyBehavior::UseBodyTransform() { return (this->body && this->live); }
 
 /// copies body transform to game object
-void RigidBodyBehavior::SyncObjectToBody() {
+void RigidBodyBehavior::SyncObjectToBody( float alpha ) {
 	
 	if ( !this->body || !this->live ) return;
 	
 	// copy from body
 	b2Vec2 pos = this->body->GetPosition();
-	float angle = (float) this->body->GetAngle() * RAD_TO_DEG;
+	float angle = (float) this->body->GetAngle();
+	
+	// interpolate from previous step
+	if ( alpha < 1 ) {
+		pos = this->previousPosition + alpha * ( pos - this->previousPosition );
+		angle = this->previousAngle + alpha * ( angle - this->previousAngle );
+	}
+	angle *= RAD_TO_DEG;
 	
 	if ( isnan( pos.x) || isnan( pos.y ) ) {
 		printf( "RigidBodyBehavior::SyncObjectToBody pos NAN\n" );
@@ -548,16 +561,69 @@ void RigidBodyBehavior::SyncObjectToBody() {
 	pos *= BOX2D_TO_WORLD_SCALE;
 	
 	// construct world transform matrix for object
-	GPU_MatrixIdentity( this->gameObject->_worldTransform );
-	GPU_MatrixTranslate( this->gameObject->_worldTransform, pos.x, pos.y, this->gameObject->_z );
-	if ( angle != 0 ) GPU_MatrixRotate( this->gameObject->_worldTransform, angle, 0, 0, 1 );
-	if ( this->gameObject->_scale.x != 1 || this->gameObject->_scale.y != 1 ) GPU_MatrixScale( this->gameObject->_worldTransform, this->gameObject->_scale.x, this->gameObject->_scale.y, 1 );
-	if ( this->gameObject->_skew.x != 1 || this->gameObject->_skew.y != 1 ) MatrixSkew( this->gameObject->_worldTransform, this->gameObject->_skew.x, this->gameObject->_skew.y );
-	this->gameObject->_worldTransformDirty = false;
+	this->gameObject->_worldTransform.Compose( pos.x, pos.y, this->gameObject->_z, angle, this->gameObject->_scale.x, this->gameObject->_scale.y, this->gameObject->_skew.x, this->gameObject->_skew.y );
+	this->gameObject->WorldTransformUpdated();
 	this->gameObject->_localCoordsAreDirty = this->gameObject->_inverseWorldDirty = this->gameObject->_transformDirty = true;
+	this->gameObject->RenderChanged( false );
+	
+	// keep syncing while body moves, or while still interpolating towards its resting position
+	this->syncPending = ( this->body->IsAwake() && this->body->GetType() != b2_staticBody ) ||
+		( alpha < 1 && ( this->previousPosition != this->body->GetPosition() || this->previousAngle != this->body->GetAngle() ) );
 		
 }
 
+/// returns true if object needs to be synced to body after physics step, false for settled sleeping and static bodies
+bool RigidBodyBehavior::NeedsSync() {
+	return this->syncPending || this->gameObject->_worldTransformDirty ||
+		( this->body->IsAwake() && this->body->GetType() != b2_staticBody );
+}
+
+/// stores current body transform as previous step's
+void RigidBodyBehavior::SavePreviousTransform() {
+	if ( !this->body ) return;
+	this->previousPosition = this->body->GetPosition();
+	this->previousAngle = this->body->GetAngle();
+	this->syncPending = true;
+	this->MarkActive();
+}
+
+/// adds to scene's active bodies list
+void RigidBodyBehavior::MarkActive() {
+	if ( this->_inActiveList || !this->_bodyScene || !this->body ) return;
+	this->_inActiveList = true;
+	this->_nextActive = NULL;
+	this->_prevActive = this->_bodyScene->activeBodiesTail;
+	if ( this->_prevActive ) this->_prevActive->_nextActive = this;
+	else this->_bodyScene->activeBodiesHead = this;
+	this->_bodyScene->activeBodiesTail = this;
+}
+
+/// removes from scene's active bodies list
+void RigidBodyBehavior::_RemoveFromActive() {
+	if ( !this->_inActiveList ) return;
+	if ( this->_prevActive ) this->_prevActive->_nextActive = this->_nextActive;
+	else this->_bodyScene->activeBodiesHead = this->_nextActive;
+	if ( this->_nextActive ) this->_nextActive->_prevActive = this->_prevActive;
+	else this->_bodyScene->activeBodiesTail = this->_prevActive;
+	this->_prevActive = this->_nextActive = NULL;
+	this->_inActiveList = false;
+}
+
+/// adds awake bodies touching or jointed to this one to active list
+void RigidBodyBehavior::MarkNeighborsActive() {
+	if ( !this->body->IsAwake() ) return;
+	for ( b2ContactEdge* ce = this->body->GetContactList(); ce; ce = ce->next ) {
+		if ( !ce->contact->IsTouching() || !ce->other->IsAwake() ) continue;
+		RigidBodyBehavior* other = (RigidBodyBehavior*) ce->other->GetUserData();
+		if ( other ) other->MarkActive();
+	}
+	for ( b2JointEdge* je = this->body->GetJointList(); je; je = je->next ) {
+		if ( !je->other->IsAwake() ) continue;
+		RigidBodyBehavior* other = (RigidBodyBehavior*) je->other->GetUserData();
+		if ( other ) other->MarkActive();
+	}
+}
+
 /// converts game object's local transform to body
 void RigidBodyBehavior::SyncBodyToObject() {
 
@@ -565,8 +631,8 @@ void RigidBodyBehavior::SyncBodyToObject() {
 	this->gameObject->body = NULL;
 	
 	// parent's world transform times local transform = this object world transform
-	if ( this->gameObject->parent ) GPU_MatrixMultiply( this->gameObject->_worldTransform, this->gameObject->parent->WorldTransform(), this->gameObject->Transform() );
-	this->gameObject->_worldTransformDirty = false;
+	if ( this->gameObject->parent ) Affine2D::Multiply( this->gameObject->_worldTransform, this->gameObject->parent->WorldTransform(), this->gameObject->Transform() );
+	this->gameObject->WorldTransformUpdated();
 	
 	// relink
 	this->gameObject->body = this;
@@ -580,6 +646,7 @@ void RigidBodyBehavior::SyncBodyToObject() {
 	pos *= WORLD_TO_BOX2D_SCALE;
 	if ( this->body ) {
 		this->body->SetTransform( pos, angle * DEG_TO_RAD );
+		this->SavePreviousTransform();
 		if ( !this->body->IsAwake() ) this->body->SetAwake( true );
 	}
 	
@@ -589,18 +656,21 @@ void RigidBodyBehavior::SyncBodyToObject() {
 void RigidBodyBehavior::SetBodyTransform( b2Vec2 pos, float angleInRad ) {
 	if ( !this->body ) return;
 	this->body->SetTransform( pos * WORLD_TO_BOX2D_SCALE, angleInRad );
+	this->SavePreviousTransform();
 }
 
 /// set body position
 void RigidBodyBehavior::SetBodyPosition( b2Vec2 pos ) {
 	if ( !this->body ) return;
 	this->body->SetTransform( pos * WORLD_TO_BOX2D_SCALE, this->body->GetAngle() );
+	this->SavePreviousTransform();
 }
 
 /// set body angle
 void RigidBodyBehavior::SetBodyAngle( float angleInRad ) {
 	if ( !this->body ) return;
 	this->body->SetTransform( this->body->GetPosition(), angleInRad );
+	this->SavePreviousTransform();
 }
 
 // gets body transform
@@ -719,6 +789,8 @@ void RigidBodyBehavior::EnableBody( bool e ) {
 	// body can't exist without shapes
 	e = ( e && this->body != NULL && shapes.size() > 0 );
 	this->live = e;
+	this->syncPending = true;
+	this->MarkActive();
 	
 	// update flag
 	if ( this->body ) {
@@ -754,10 +826,12 @@ void RigidBodyBehavior::AddBody( Scene *scene ) {
 	bodyDef.type = bodyType;
 	
 	// create body
+	this->_bodyScene = scene;
 	this->body = scene->world->CreateBody( &bodyDef );
 	this->body->SetMassData( &massData );
 	this->body->SetLinearVelocity( this->velocity );
 	this->body->SetAngularVelocity( this->angularVelocity * DEG_TO_RAD );
+	this->SavePreviousTransform();
 	
 	// add shapes/fixtures
 	for ( size_t i = 0, nf = shapes.size(); i < nf; i++ ) {
@@ -790,6 +864,8 @@ void RigidBodyBehavior::RemoveBody() {
 		}
 		this->body->GetWorld()->DestroyBody( this->body );
 	}
+	this->_RemoveFromActive();
+	this->_bodyScene = NULL;
 	this->body = NULL;
 
 }
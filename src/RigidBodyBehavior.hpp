@@ -93,8 +93,38 @@ public:
 	/// turns body on and off ( active switch )
 	void EnableBody( bool e );
 	
-	/// called after physics step on each body to sync position and rotation
-	void SyncObjectToBody();
+	/// called after physics step on each body to sync position and rotation, alpha < 1 interpolates from previous step
+	void SyncObjectToBody( float alpha=1 );
+	
+	/// body transform before last physics step, in box2d units
+	b2Vec2 previousPosition = { 0, 0 };
+	float previousAngle = 0;
+	
+	/// stores current body transform as previous step's, for interpolation
+	void SavePreviousTransform();
+	
+	/// true when object may be out of sync with body ( body was awake, teleported, or is still interpolating )
+	bool syncPending = true;
+	
+	/// returns true if object needs to be synced to body after physics step, false for settled sleeping and static bodies
+	bool NeedsSync();
+	
+	/// scene body was added to
+	Scene* _bodyScene = NULL;
+	
+	/// links in scene's list of bodies that need syncing
+	RigidBodyBehavior* _prevActive = NULL;
+	RigidBodyBehavior* _nextActive = NULL;
+	bool _inActiveList = false;
+	
+	/// adds to scene's active bodies list ( on wake, teleport, enable ), it's removed once synced and settled
+	void MarkActive();
+	
+	/// removes from scene's active bodies list
+	void _RemoveFromActive();
+	
+	/// adds awake bodies touching or jointed to this one to active list ( Box2D wakes whole islands )
+	void MarkNeighborsActive();
 	
 	/// call to sync body to manually set object position
 	void SyncBodyToObject();
@@ -649,9 +649,19 @@ void RigidBodyJoint::SetOtherBody( RigidBodyBehavior* newBody ) {
  -------------------------------------------------------------------- */
 
 
+// motor and limit changes wake bodies
+void RigidBodyJoint::NativePropertyChanged() {
+	if ( this->body ) this->body->MarkActive();
+	if ( this->otherBody ) this->otherBody->MarkActive();
+}
+
 // destroys and remakes the joint
 void RigidBodyJoint::UpdateJoint() {
 	
+	// adding / removing joint wakes bodies
+	if ( this->body ) this->body->MarkActive();
+	if ( this->otherBody ) this->otherBody->MarkActive();
+	
 	// destroy old
 	if ( this->joint ) {
         // find world
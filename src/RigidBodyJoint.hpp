@@ -43,6 +43,9 @@ public:
 	// rebuilds joint
 	void UpdateJoint();
 	
+	/// script set a property ( motor, limits ), wakes bodies
+	void NativePropertyChanged();
+	
 	void SetBody( RigidBodyBehavior* b );
 	void SetOtherBody( RigidBodyBehavior* b );
 	
@@ -23,6 +23,8 @@ Scene::Scene( ScriptArguments* args ) : Scene() {
 	// create color object
 	backgroundColor = new Color( NULL );
 	backgroundColor->SetInts( 25, 50, 75, 255 );
+	shared_ptr<bool> alive = this->_colorOwnerAlive;
+	backgroundColor->callback = [this, alive]( Color* c ){ if ( *alive ) this->RenderChanged(); };
 	script.SetProperty( "backgroundColor", ArgValue( backgroundColor->scriptObject ), this->scriptObject );
 
 	// event mask
@@ -74,6 +76,9 @@ Scene::Scene() {
 // scene clean up
 Scene::~Scene() {
 	
+	// background color can outlive scene, its callback becomes a no-op
+	*this->_colorOwnerAlive = false;
+	
     // remove all particle systems
     while( this->particleSystems.size() ) {
         this->particleSystems.back()->SetScene(NULL);
@@ -121,7 +126,7 @@ void Scene::InitClass() {
 		if ( val.type == TypeObject ) {
 			// replace if it's a color
 			Color* other = script.GetInstance<Color>( val.value.objectValue );
-			if ( other ) rs->backgroundColor = other;
+			Color::Replace( rs->backgroundColor, other );
 		} else {
 			rs->backgroundColor->Set( val );
 		}
@@ -216,6 +221,22 @@ void Scene::InitClass() {
 		return val;
 	}));
 	
+	script.AddProperty<Scene>
+	( "physicsStep",
+	 static_cast<ScriptFloatCallback>([](void* o, float) { return ((Scene*) o)->physicsStep; }),
+	 static_cast<ScriptFloatCallback>([](void* o, float val ) {
+		Scene* s = (Scene*) o;
+		s->physicsStep = max( 0.0f, val );
+		s->physicsAccumulator = 0;
+		s->physicsAlpha = 1;
+		return s->physicsStep;
+	}));
+	
+	script.AddProperty<Scene>
+	( "physicsMaxSubsteps",
+	 static_cast<ScriptIntCallback>([](void* o, int) { return ((Scene*) o)->physicsMaxSubsteps; }),
+	 static_cast<ScriptIntCallback>([](void* o, int val ) { return ( ((Scene*) o)->physicsMaxSubsteps = max( 1, val ) ); }));
+	
     script.AddProperty<Scene>
     ( "particleSystems",
      static_cast<ScriptArrayCallback>([](void *go, ArgValueVector* in ) { return ((Scene*) go)->GetParticleSystemsVector(); }),
@@ -487,6 +508,14 @@ void Scene::TraceProtectedObjects( vector<void **> &protectedObjects ) {
         protectedObjects.push_back( &this->particleSystems[ i ]->scriptObject );
     }
     
+	// subscribers being dispatched
+	for ( size_t i = 0, nd = this->dispatchingSubscribers.size(); i < nd; i++ ) {
+		GameObjectVector& subscribers = *this->dispatchingSubscribers[ i ];
+		for ( size_t j = 0, ns = subscribers.size(); j < ns; j++ ) {
+			protectedObjects.push_back( &subscribers[ j ]->scriptObject );
+		}
+	}
+	
 	// call super
 	GameObject::TraceProtectedObjects( protectedObjects );
 }
@@ -510,6 +539,83 @@ void Scene::DispatchEvent( Event& event, bool callOnSelf, GameObjectCallback *fo
 	
 }
 
+/// calls event only on subscribed objects, instead of traversing entire hierarchy
+void Scene::DispatchToSubscribers( Event& event ) {
+	
+	// bubbling and UI events need full traversal
+	if ( event.bubbles || event.isBlockableUIEvent ) {
+		this->DispatchEvent( event, true );
+		return;
+	}
+	
+	// set self
+	event.scene = this;
+	
+	// copy, because handlers may change hierarchy, and protect from GC while dispatching
+	GameObjectVector subscribers = this->GetEventSubscribers( event.id );
+	this->dispatchingSubscribers.push_back( &subscribers );
+	
+	// object that asked to skip its children
+	GameObject* skipChildrenOf = NULL;
+	
+	// subscribers are in the same order as DispatchEvent would visit them
+	for ( size_t i = 0, ns = subscribers.size(); i < ns && !event.stopped; i++ ) {
+		GameObject* obj = subscribers[ i ];
+		if ( !this->_SubscriberReceivesEvent( obj, event, skipChildrenOf ) ) continue;
+		obj->CallEvent( event );
+		
+		// behavior said skip children
+		if ( event.skipChildren ) {
+			event.skipChildren = false;
+			skipChildrenOf = obj;
+		}
+	}
+	
+	// done
+	this->dispatchingSubscribers.pop_back();
+}
+
+/// returns subscribers to event, rebuilding list if anything changed
+GameObjectVector& Scene::GetEventSubscribers( EventId eventId ) {
+	EventSubscribers& subs = this->eventSubscribers[ eventId ];
+	// changes elsewhere ( other scenes, detached objects ) don't affect this list
+	GameObject* overlay = app.overlay;
+	if ( subs.version < subscriptionsResetVersion || subs.version < this->_subscriptionsVersion ||
+		subs.overlay != overlay || ( overlay && subs.version < overlay->_subscriptionsVersion ) ) {
+		subs.objects.clear();
+		// overlay goes first
+		if ( overlay ) this->_CollectSubscribers( overlay, eventId, subs.objects );
+		this->_CollectSubscribers( this, eventId, subs.objects );
+		subs.version = subscriptionsVersion;
+		subs.overlay = overlay;
+	}
+	return subs.objects;
+}
+
+/// self first, then children last to first, same as DispatchEvent
+void Scene::_CollectSubscribers( GameObject* obj, EventId eventId, GameObjectVector& out ) {
+	if ( obj->SubscribesToEvent( eventId ) ) out.push_back( obj );
+	for ( int i = (int) obj->children.size() - 1; i >= 0; i-- ) {
+		this->_CollectSubscribers( obj->children[ i ], eventId, out );
+	}
+}
+
+/// walks up to scene or overlay, checking each object on the way like DispatchEvent would
+bool Scene::_SubscriberReceivesEvent( GameObject* obj, Event& event, GameObject* skipChildrenOf ) {
+	for ( GameObject* o = obj; o != NULL; o = o->parent ) {
+		// masked
+		if ( o->MasksEvent( event ) ) return false;
+		// ancestor asked to skip children
+		if ( o == skipChildrenOf && o != obj ) return false;
+		// reached root
+		if ( o == this || o == app.overlay ) return true;
+		// inactive or skipped
+		if ( !o->scriptObject || !o->active() || o == event.skipObject || o == event.skipObject2 ) return false;
+	}
+	// no longer in scene
+	return false;
+}
+
 
 /* MARK:	-				Render
  -------------------------------------------------------------------- */
@@ -565,6 +671,7 @@ void Scene::Render( Event& event ) {
 	
 	// debug draw world
 	if ( app.debugDraw ) {
+		RenderBehavior::FlushSpriteBatch();
 		GPU_DeactivateShaderProgram(); // GPU_ActivateShaderProgram( 0, NULL );
 		this->world->DrawDebugData();
 	}
@@ -935,31 +1042,69 @@ void Scene::SimulatePhysics() {
 	// clear physics events
 	physicsEvents.clear();
 	
-	// step world
-	this->world->Step( app.deltaTime, BOX2D_VELOCITY_ITERATIONS, BOX2D_POSITION_ITERATIONS );
-	
-	// sync positions of bodies with GameObjects
-	b2Body* body = this->world->GetBodyList();
-	while( body != NULL ) {
+	// fixed timestep
+	if ( this->physicsStep > 0 ) {
 		
-		// call sync on RigidBodyBehavior
-		RigidBodyBehavior* rbb = (RigidBodyBehavior*) body->GetUserData();
-		if ( rbb != NULL && rbb->live ) rbb->SyncObjectToBody();
+		// add frame time, and take whole steps out of it
+		this->physicsAccumulator += app.deltaTime;
+		int steps = (int) floor( this->physicsAccumulator / this->physicsStep );
+		this->physicsAccumulator -= steps * this->physicsStep;
 		
-		// keep going
-		body = body->GetNext();
+		// if too far behind, drop extra time instead of taking more and more steps
+		if ( steps > this->physicsMaxSubsteps ) steps = this->physicsMaxSubsteps;
 		
+		// forces applied this frame act on every step
+		this->world->SetAutoClearForces( false );
+		for ( int i = 0; i < steps; i++ ) {
+			// remember transforms before last step, to interpolate from
+			if ( i == steps - 1 ) this->SavePreviousBodyTransforms();
+			this->world->Step( this->physicsStep, BOX2D_VELOCITY_ITERATIONS, BOX2D_POSITION_ITERATIONS );
+		}
+		// forces only last for the frame they were applied in, even if no steps were taken
+		this->world->ClearForces();
+		
+		// leftover time
+		this->physicsAlpha = this->physicsAccumulator / this->physicsStep;
+		
+	// variable timestep
+	} else {
+		this->world->SetAutoClearForces( true );
+		this->world->Step( app.deltaTime, BOX2D_VELOCITY_ITERATIONS, BOX2D_POSITION_ITERATIONS );
+		this->physicsAlpha = 1;
 	}
-    
+	
     // particle systems
     for ( size_t i = 0, nps = this->particleSystems.size(); i < nps; i++ ) {
         ParticleSystem* ps = this->particleSystems[ i ];
         if ( ps->active ) {
+            // bodies pushed by particles
+            const b2ParticleBodyContact* contacts = ps->particleSystem->GetBodyContacts();
+            for ( int32 c = 0, nc = ps->particleSystem->GetBodyContactCount(); c < nc; c++ ) {
+                RigidBodyBehavior* rbb = (RigidBodyBehavior*) contacts[ c ].body->GetUserData();
+                if ( rbb != NULL && contacts[ c ].body->IsAwake() ) rbb->MarkActive();
+            }
             // update groups
-            ps->SyncObjectsToGroups();
+            ps->SyncObjectsToGroups( this->physicsAlpha );
         }
     }
 	
+	// sync positions of moved bodies with GameObjects ( bodies woken with them are appended and visited in the same pass )
+	RigidBodyBehavior* rbb = this->activeBodiesHead;
+	while( rbb != NULL ) {
+		
+		// call sync on RigidBodyBehavior
+		if ( rbb->live ) {
+			rbb->MarkNeighborsActive();
+			if ( rbb->NeedsSync() ) rbb->SyncObjectToBody( this->physicsAlpha );
+		}
+		
+		// drop once settled
+		RigidBodyBehavior* next = rbb->_nextActive;
+		if ( !rbb->live || !rbb->NeedsSync() ) rbb->_RemoveFromActive();
+		rbb = next;
+		
+	}
+	
 	// dispatch physics events
 	for ( size_t i = 0, ne = physicsEvents.size(); i < ne; i++ ){
 		physicsEvents[ i ]();
@@ -967,6 +1112,22 @@ void Scene::SimulatePhysics() {
 	
 }
 
+/// stores current transforms of bodies and rigid particle groups for interpolation
+void Scene::SavePreviousBodyTransforms() {
+	
+	// bodies
+	for ( RigidBodyBehavior* rbb = this->activeBodiesHead; rbb != NULL; rbb = rbb->_nextActive ) {
+		if ( rbb->live && rbb->NeedsSync() ) rbb->SavePreviousTransform();
+	}
+	
+	// particle groups
+	for ( size_t i = 0, nps = this->particleSystems.size(); i < nps; i++ ) {
+		ParticleSystem* ps = this->particleSystems[ i ];
+		if ( ps->active ) ps->SavePreviousGroupTransforms();
+	}
+	
+}
+
 
 /// returns ArgValueVector with each PS's scriptObject
 ArgValueVector* Scene::GetParticleSystemsVector() {
@@ -42,6 +42,25 @@ public:
     ArgValueVector* GetParticleSystemsVector();
     ArgValueVector* SetParticleSystemsVector( ArgValueVector* in );
 	
+	/// fixed physics step in seconds, 0 = step by frame's deltaTime
+	float physicsStep = 0;
+	
+	/// max number of fixed steps per frame, extra time is dropped
+	int physicsMaxSubsteps = 5;
+	
+	/// unsimulated time carried over to next frame
+	float physicsAccumulator = 0;
+	
+	/// 0 - 1, how far between previous and current physics step the rendered transforms are
+	float physicsAlpha = 1;
+	
+	/// stores current transforms of bodies and rigid particle groups for interpolation
+	void SavePreviousBodyTransforms();
+	
+	/// bodies that may need syncing after physics step ( awake, teleported, or interpolating ), linked through RigidBodyBehavior::_nextActive
+	RigidBodyBehavior* activeBodiesHead = NULL;
+	RigidBodyBehavior* activeBodiesTail = NULL;
+	
 	typedef function<void()> PhysicsEventCallback;
 	
 	vector<PhysicsEventCallback> physicsEvents;
@@ -140,6 +159,9 @@ public:
 	// clear color
 	Color *backgroundColor = NULL;
 	
+	/// captured by backgroundColor callback, cleared in destructor ( script can hold on to color after scene is gone )
+	shared_ptr<bool> _colorOwnerAlive = make_shared<bool>( true );
+	
 	// camera
 	float inverseCameraMatrix[ 16 ];
 	float cameraMatrix[ 16 ];
@@ -157,6 +179,31 @@ public:
 	/// overridden from GameObject to affect overlay
 	void DispatchEvent( Event& event, bool callOnSelf=false, GameObjectCallback *forEachGameObject=NULL);
 	
+	/// flat list of objects subscribed to an event, in dispatch order
+	struct EventSubscribers {
+		GameObjectVector objects;
+		uint32_t version = 0;
+		GameObject* overlay = NULL;
+	};
+	
+	/// event id -> subscribers in overlay and this scene
+	unordered_map<EventId, EventSubscribers> eventSubscribers;
+	
+	/// subscriber lists currently being dispatched, protected from GC
+	vector<GameObjectVector*> dispatchingSubscribers;
+	
+	/// calls event only on objects subscribed to it, with same order, eventMask, active and stopped rules as DispatchEvent( event, true )
+	void DispatchToSubscribers( Event& event );
+	
+	/// returns subscribers to event, rebuilt if hierarchy or event handlers have changed since last call
+	GameObjectVector& GetEventSubscribers( EventId eventId );
+	
+	/// helper - appends objects in subtree that subscribe to event, in dispatch order
+	void _CollectSubscribers( GameObject* obj, EventId eventId, GameObjectVector& out );
+	
+	/// helper - true if subscriber is still in scene / overlay, and isn't masked, inactive, or skipped
+	bool _SubscriberReceivesEvent( GameObject* obj, Event& event, GameObject* skipChildrenOf );
+	
 // hierarchy
 	
 	/// returns scene
@@ -752,6 +752,55 @@ void ScriptHost::CopyProperties( void* src, void* dest ) {
 	
 }
 
+/* MARK:	-				Property hooks
+ -------------------------------------------------------------------- */
+
+
+/// if a script property named like an event changes, instance's event handlers have changed
+void ScriptHost::ScriptPropertyChanged( void* self, jsid id ) {
+	
+	// new event names may match previously seen properties
+	if ( script.eventIdsByPropIdNames != Event::NumNames() ) {
+		script.eventIdsByPropId.clear();
+		script.eventIdsByPropIdNames = Event::NumNames();
+	}
+	
+	// look up by id, name is only encoded first time property is seen
+	EventId eventId;
+	size_t key = (size_t) JSID_BITS( id );
+	unordered_map<size_t, EventId>::iterator it = script.eventIdsByPropId.find( key );
+	if ( it != script.eventIdsByPropId.end() ) {
+		eventId = it->second;
+	} else {
+		char *propName = JS_EncodeString( script.js, JSID_TO_STRING( id ) );
+		eventId = Event::FindIdForName( propName );
+		// pin name, so id isn't reused for another string
+		JS_InternString( script.js, propName );
+		JS_free( script.js, propName );
+		script.eventIdsByPropId[ key ] = eventId;
+	}
+	if ( eventId == EVENTID_NONE ) return;
+	// instance
+	if ( self ) {
+		((ScriptableClass*) self)->EventHandlersChanged( eventId );
+	// prototype - affects every instance
+	} else {
+		ScriptableClass::propertyHandlersVersion++;
+		ScriptableClass::subscriptionsResetVersion = ++ScriptableClass::subscriptionsVersion;
+	}
+}
+
+/// lets instance react to native property change
+void ScriptHost::NativePropertyChanged( void* self ) {
+	((ScriptableClass*) self)->NativePropertyChanged();
+}
+
+/// direct assignment overrides tweens of the same property ( tweens' own sets are skipped )
+void ScriptHost::NativePropertyAssigned( void* self, const char* propName ) {
+	if ( Tween::applyingValues || !propName ) return;
+	Tween::StopTweens( ((ScriptableClass*) self)->scriptObject, propName );
+}
+
 /* MARK:	-				Logging
  -------------------------------------------------------------------- */
 
@@ -761,7 +810,7 @@ bool ScriptHost::Log( JSContext *cx, unsigned argc, Value *vp ) {
 	//JSAutoRequest req( cx );
 	
 	// determine if there's log handler registered
-	ScriptableClass::EventListenersMap::iterator hit = app.eventListeners.find( string( EVENT_LOG ) );
+	ScriptableClass::EventListenersMap::iterator hit = app.eventListeners.find( EVENTID_LOG );
 	bool hasHandler = ( hit != app.eventListeners.end() && hit->second.size() > 0 );
 	if ( !hasHandler ) {
 		ArgValue hval = script.GetProperty( EVENT_LOG, app.scriptObject );
@@ -843,7 +892,7 @@ void ScriptHost::ErrorReport ( JSContext *cx, const char *message, JSErrorReport
 	}
 	
 	// determine if there's error handler registered
-	ScriptableClass::EventListenersMap::iterator hit = app.eventListeners.find( string( EVENT_ERROR ) );
+	ScriptableClass::EventListenersMap::iterator hit = app.eventListeners.find( EVENTID_ERROR );
 	bool hasHandler = ( hit != app.eventListeners.end() && hit->second.size() > 0 );
 	if ( !hasHandler ) {
 		ArgValue hval = script.GetProperty( EVENT_ERROR, app.scriptObject );
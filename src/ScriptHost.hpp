@@ -113,6 +113,9 @@ private:
 		ScriptType type;
 		ScriptCallback getterSetter[2];
 		unsigned flags = 0;
+		
+		/// property name ( points to key in ClassDef::getterSetter )
+		const char* name = NULL;
 	
 		// constructor with type
 		GetterSetter( ScriptType st, unsigned flags ) : type( st ), flags( flags ) {}
@@ -193,6 +196,12 @@ private:
 		/// property name -> getter + setter
 		GetterSetterMap getterSetter;
 		
+		/// interned property id -> getter + setter, points into getterSetter
+		unordered_map<size_t, GetterSetter*> getterSetterById;
+		
+		/// "#" index getter + setter, or NULL
+		GetterSetter* indexGetterSetter = NULL;
+		
 		/// funcname -> ScriptFunctionCallback
 		FuncMap funcs;
 
@@ -208,6 +217,9 @@ private:
 	/// class definitions
 	ClassMap classDefinitions;
 	
+	/// JSClass -> class definition, for fast lookup in property callbacks
+	unordered_map<const JSClass*, ClassDef*> classDefinitionsByJSClass;
+	
 	/// global Javascript class
 	JSClass global_class;
 	
@@ -228,98 +240,164 @@ private:
 		return p == script.classDefinitions.end() ? NULL : &p->second;
 	}
 	
-	/// generic resolver + getter/setter
-	bool PropGetterSetter( JSContext *cx, int getOrSet, void* self, ClassDef* cdef, string& propName, JS::MutableHandleValue vp, uint32_t index=0 ) {
-		
-		// get callback
-		GetterSetterMapIterator gsi = cdef->getterSetter.find( propName );
-		
-		// if found
-		if ( gsi != cdef->getterSetter.end() ) {
-			GetterSetter *gs = &gsi->second;
-			
-			// if setting a read only prop, fail
-			if ( getOrSet == 1 && ( gs->flags & PROP_READONLY ) ) return false;
-			
-			// based on property type, call callback
-			if ( gs->type == TypeFloat ) {
-				double dval = 0;
-				ToNumber( cx, vp, &dval );
-				vp.setDouble( (double) gs->getterSetter[getOrSet].floatCallback( self, (float) dval ) );
-			} else if ( gs->type == TypeInt ){
-				int32_t ival = 0;
-				ToInt32( cx, vp, &ival );
-				vp.setInt32( gs->getterSetter[getOrSet].intCallback( self, ival ) );
-			} else if ( gs->type == TypeBool ) {
-				bool bval = ToBoolean( vp );
-				vp.setBoolean( gs->getterSetter[getOrSet].boolCallback( self, bval ) );
-			} else if ( gs->type == TypeObject ) {
-				JSObject* oval = vp.isObjectOrNull() ? vp.toObjectOrNull() : NULL;
-				vp.setObjectOrNull( (JSObject*) gs->getterSetter[getOrSet].objectCallback( self, oval ) );
-			} else if ( gs->type == TypeValue ) {
-				vp.set( gs->getterSetter[getOrSet].valueCallback ( self, ArgValue( vp.get() ) ).toValue() );
-			} else if ( gs->type == TypeString ){
-				JSString* str = JS_ValueToString( cx, vp );
-				char* sval = JS_EncodeString( cx, str );
-				string stval = sval;
-				JS_free( cx, sval );
-				stval = gs->getterSetter[getOrSet].stringCallback( self, stval );
-				RootedString str2( cx, JS_NewStringCopyZ( cx, stval.c_str() ) );
-				vp.setString( str2 );
-			} else if ( gs->type == TypeIndex ) {
-				vp.set( gs->getterSetter[getOrSet].indexCallback ( self, index, ArgValue( vp.get() ) ).toValue() );
-			} else if ( gs->type == TypeArray ){
-				ArgValue av( vp.get() );
-				ArgValueVector *in = av.value.arrayValue;
-				ArgValueVector *out = gs->getterSetter[getOrSet].arrayCallback( self, in );
-				if ( out ) {
-					vp.set( ScriptArguments::ArrayToVal( *out ) );
-					if ( out != in ) delete out;
-				} else {
-					vp.setNull();
-				}				
-			}
-			
-			// bail if exception in getter or setter
-			return !JS_IsExceptionPending( script.js );
-			
-		} else if ( cdef->parent ) {
-			
-			// try in parent
-			return script.PropGetterSetter( cx, getOrSet, self, cdef->parent, propName, vp );
-			
+	/// helper to look up class definition by JSClass
+	inline static ClassDef* CDEF( const JSClass* jsc ) {
+		unordered_map<const JSClass*, ClassDef*>::iterator p = script.classDefinitionsByJSClass.find( jsc );
+		return p == script.classDefinitionsByJSClass.end() ? NULL : p->second;
+	}
+	
+	/// stores getter + setter under property name, and under its interned id
+	void _SetGetterSetter( ClassDef* classDef, const char* propName, GetterSetter& gs ) {
+		GetterSetterMap::iterator it = classDef->getterSetter.emplace( string( propName ), gs ).first;
+		GetterSetter& stored = it->second;
+		stored = gs;
+		stored.name = it->first.c_str();
+		if ( propName[ 0 ] == '#' && propName[ 1 ] == 0 ) {
+			classDef->indexGetterSetter = &stored;
+		} else {
+			// interned strings are never collected, so id stays valid
+			JSString* str = JS_InternString( this->js, propName );
+			classDef->getterSetterById[ (size_t) JSID_BITS( INTERNED_STRING_TO_JSID( this->js, str ) ) ] = &stored;
+		}
+	}
+	
+	/// finds getter + setter for property id in class, or its parents
+	static GetterSetter* FindGetterSetter( ClassDef* cdef, jsid id ) {
+		size_t key = (size_t) JSID_BITS( id );
+		while ( cdef ) {
+			unordered_map<size_t, GetterSetter*>::iterator it = cdef->getterSetterById.find( key );
+			if ( it != cdef->getterSetterById.end() ) return it->second;
+			cdef = cdef->parent;
+		}
+		return NULL;
+	}
+	
+	/// finds index getter + setter in class, or its parents
+	static GetterSetter* FindIndexGetterSetter( ClassDef* cdef ) {
+		while ( cdef && !cdef->indexGetterSetter ) cdef = cdef->parent;
+		return cdef ? cdef->indexGetterSetter : NULL;
+	}
+	
+	/// calls native getter or setter, converting value
+	bool CallGetterSetter( JSContext *cx, int getOrSet, void* self, GetterSetter* gs, JS::MutableHandleValue vp, uint32_t index=0 ) {
+		
+		// if setting a read only prop, fail
+		if ( getOrSet == 1 && ( gs->flags & PROP_READONLY ) ) return false;
+		
+		// based on property type, call callback
+		if ( gs->type == TypeFloat ) {
+			double dval = 0;
+			ToNumber( cx, vp, &dval );
+			vp.setDouble( (double) gs->getterSetter[getOrSet].floatCallback( self, (float) dval ) );
+		} else if ( gs->type == TypeInt ){
+			int32_t ival = 0;
+			ToInt32( cx, vp, &ival );
+			vp.setInt32( gs->getterSetter[getOrSet].intCallback( self, ival ) );
+		} else if ( gs->type == TypeBool ) {
+			bool bval = ToBoolean( vp );
+			vp.setBoolean( gs->getterSetter[getOrSet].boolCallback( self, bval ) );
+		} else if ( gs->type == TypeObject ) {
+			JSObject* oval = vp.isObjectOrNull() ? vp.toObjectOrNull() : NULL;
+			vp.setObjectOrNull( (JSObject*) gs->getterSetter[getOrSet].objectCallback( self, oval ) );
+		} else if ( gs->type == TypeValue ) {
+			vp.set( gs->getterSetter[getOrSet].valueCallback ( self, ArgValue( vp.get() ) ).toValue() );
+		} else if ( gs->type == TypeString ){
+			JSString* str = JS_ValueToString( cx, vp );
+			char* sval = JS_EncodeString( cx, str );
+			string stval = sval;
+			JS_free( cx, sval );
+			stval = gs->getterSetter[getOrSet].stringCallback( self, stval );
+			RootedString str2( cx, JS_NewStringCopyZ( cx, stval.c_str() ) );
+			vp.setString( str2 );
+		} else if ( gs->type == TypeIndex ) {
+			vp.set( gs->getterSetter[getOrSet].indexCallback ( self, index, ArgValue( vp.get() ) ).toValue() );
+		} else if ( gs->type == TypeArray ){
+			ArgValue av( vp.get() );
+			ArgValueVector *in = av.value.arrayValue;
+			ArgValueVector *out = gs->getterSetter[getOrSet].arrayCallback( self, in );
+			if ( out ) {
+				vp.set( ScriptArguments::ArrayToVal( *out ) );
+				if ( out != in ) delete out;
+			} else {
+				vp.setNull();
+			}				
 		}
 		
-		// not found
-		return true;
+		// bail if exception in getter or setter
+		return !JS_IsExceptionPending( script.js );
 		
 	}
 	
+	/// notifies instance ( or all instances, if self is NULL ) that a script defined property was added, set, or deleted ( implemented in ScriptHost.cpp )
+	static void ScriptPropertyChanged( void* self, jsid id );
+	
+	/// property id -> EventId ( or EVENTID_NONE ), so script property sets don't encode the name
+	unordered_map<size_t, EventId> eventIdsByPropId;
+	
+	/// number of event names when eventIdsByPropId was last validated ( new event names invalidate EVENTID_NONE entries )
+	size_t eventIdsByPropIdNames = 0;
+	
+	/// notifies instance that one of its native properties was set ( implemented in ScriptHost.cpp )
+	static void NativePropertyChanged( void* self );
+	
+	/// script assigned native property directly - stops tweens running on it ( implemented in ScriptHost.cpp )
+	static void NativePropertyAssigned( void* self, const char* propName );
+	
+	/// generic add / delete property hook
+	static void PropAddedOrDeleted( JSContext *cx, HandleObject obj, HandleId id ) {
+		// find instance
+		JSClass* jc = JS_GetClass( obj );
+		if ( !( jc->flags & JSCLASS_HAS_PRIVATE ) || !JSID_IS_STRING( id ) ) return;
+		void* self = JS_GetPrivate( obj ); // NULL for prototype
+		ScriptPropertyChanged( self, id );
+	}
+	
+	/// generic add property hook
+	static bool PropAdder( JSContext *cx, HandleObject obj, HandleId id, MutableHandleValue vp ){
+		PropAddedOrDeleted( cx, obj, id );
+		return true;
+	}
+	
+	/// generic delete property hook
+	static bool PropDeleter( JSContext *cx, HandleObject obj, HandleId id, JSBool *succeeded ){
+		PropAddedOrDeleted( cx, obj, id );
+		*succeeded = true;
+		return true;
+	}
+	
 	/// generic setter
 	static bool PropSetter( JSContext *cx, HandleObject obj, HandleId id, bool strict, MutableHandleValue vp ){
-		// scoped request
-		//JSAutoRequest req( cx );
-		//JSAutoCompartment( cx, obj );
 		
 		// find class
 		JSClass* jc = JS_GetClass( obj );
 		if ( !( jc->flags & JSCLASS_HAS_PRIVATE )) return false;
 		void* self =  JS_GetPrivate( obj );
 		if ( !self ) return false;
-		ClassDef *cdef = CDEF( string( jc->name ) );
-		
-		// if found, and [id] is string
-		if ( cdef && JSID_IS_STRING( id ) ) {
-			// get property name
-			char *idString = JS_EncodeString( cx, JSID_TO_STRING( id ) );
-			string propName(idString);
-			JS_free( cx, idString );
+		ClassDef *cdef = CDEF( jc );
+		if ( !cdef ) return true;
+		
+		// [id] is string
+		if ( JSID_IS_STRING( id ) ) {
+			// native property
+			GetterSetter* gs = FindGetterSetter( cdef, id );
+			if ( gs ) {
+				NativePropertyAssigned( self, gs->name );
+				bool ok = script.CallGetterSetter( cx, 1, self, gs, vp );
+				NativePropertyChanged( self );
+				return ok;
+			}
+			
+			// script defined property is being set
+			ScriptPropertyChanged( self, id );
 			
-			return script.PropGetterSetter( cx, 1, self, cdef, propName, vp );
 		// id is integer
 		} else if( JSID_IS_INT( id ) ) {
-			string numProp("#");
-			return script.PropGetterSetter( cx, 1, self, cdef, numProp, vp, JSID_TO_INT( id ) );
+			GetterSetter* gs = FindIndexGetterSetter( cdef );
+			if ( gs ) {
+				bool ok = script.CallGetterSetter( cx, 1, self, gs, vp, JSID_TO_INT( id ) );
+				NativePropertyChanged( self );
+				return ok;
+			}
 		}
 		
 		return true;
@@ -333,21 +411,18 @@ private:
 		if ( !( jc->flags & JSCLASS_HAS_PRIVATE )) return false;
 		void* self =  JS_GetPrivate( obj );
 		if ( !self ) return false;
-		ClassDef *cdef = CDEF( string( jc->name ) );
-		
-		// if found, and [id] is string
-		if ( cdef && JSID_IS_STRING( id ) ) {
-			// get property name
-			char *idString = JS_EncodeString( cx, JSID_TO_STRING( id ) );
-			string propName(idString);
-			JS_free( cx, idString );
-			
-			return script.PropGetterSetter( cx, 0, self, cdef, propName, vp );
+		ClassDef *cdef = CDEF( jc );
+		if ( !cdef ) return true;
+		
+		// [id] is string
+		if ( JSID_IS_STRING( id ) ) {
+			GetterSetter* gs = FindGetterSetter( cdef, id );
+			if ( gs ) return script.CallGetterSetter( cx, 0, self, gs, vp );
 			
 		// id is integer
 		} else if( JSID_IS_INT( id ) ){
-			string numProp("#");
-			return script.PropGetterSetter( cx, 0, self, cdef, numProp, vp, JSID_TO_INT( id ) );
+			GetterSetter* gs = FindIndexGetterSetter( cdef );
+			if ( gs ) return script.CallGetterSetter( cx, 0, self, gs, vp, JSID_TO_INT( id ) );
 		}
 		
 		return true;
@@ -764,10 +839,13 @@ public:
 		def->className = ScriptClassDesc<CLASS>::name();
 		def->singleton = singleton;
 		def->jsc.name = def->className.c_str(),
+		classDefinitionsByJSClass[ &def->jsc ] = def;
 		def->jsc.finalize = (JSFinalizeOp) ScriptHost::Finalize<CLASS>;
 		def->jsc.trace = (JSTraceOp) ScriptHost::TraceScriptableClass<CLASS>;
 		def->jsc.getProperty = (JSPropertyOp) ScriptHost::PropGetter;
 		def->jsc.setProperty = (JSStrictPropertyOp) ScriptHost::PropSetter;
+		def->jsc.addProperty = (JSPropertyOp) ScriptHost::PropAdder;
+		def->jsc.delProperty = (JSDeletePropertyOp) ScriptHost::PropDeleter;
 		if ( ScriptClassDesc<CLASS>::enumerate() != NULL ){
 			def->jsc.enumerate = (JSEnumerateOp) ScriptHost::EnumerateProp<CLASS>;
 			def->jsc.flags |= JSCLASS_NEW_ENUMERATE;
@@ -811,14 +889,14 @@ public:
 		//JSAutoRequest req( this->js );
 		ClassDef *classDef = CDEF( ScriptClassDesc<CLASS>::name() );
 		GetterSetter gs( TypeIndex, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string("#") ] = gs;
+		_SetGetterSetter( classDef, "#", gs );
 	}
 	
 	template <class CLASS>
 	void AddIndexProperty( ScriptIndexCallback getter, unsigned flags=PROP_NOSTORE|PROP_NOSTORE ){ 
 		ClassDef *classDef = CDEF( ScriptClassDesc<CLASS>::name() );
 		GetterSetter gs( TypeIndex, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string("#") ] = gs;
+		_SetGetterSetter( classDef, "#", gs );
 	}
 	
 	template <class CLASS>
@@ -829,7 +907,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeValue, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -840,7 +918,7 @@ public:
 		JS_DefineProperty( this->js, ((flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeValue, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -851,7 +929,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_ZERO, NULL, NULL, jflags );
 		GetterSetter gs( TypeInt, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -862,7 +940,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_ZERO, NULL, NULL, jflags);
 		GetterSetter gs( TypeInt, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 
 	template <class CLASS>
@@ -873,7 +951,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_ZERO, NULL, NULL, jflags );
 		GetterSetter gs( TypeFloat, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -884,7 +962,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_ZERO, NULL, NULL, jflags );
 		GetterSetter gs( TypeFloat, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -895,7 +973,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_FALSE, NULL, NULL, jflags );
 		GetterSetter gs( TypeBool, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -906,7 +984,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_FALSE, NULL, NULL, jflags );
 		GetterSetter gs( TypeBool, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -917,7 +995,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeString, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -928,7 +1006,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeString, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -939,7 +1017,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeObject, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -950,7 +1028,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeObject, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -961,7 +1039,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags );
 		GetterSetter gs( TypeArray, flags ); gs.Init( &getter, &setter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 	template <class CLASS>
@@ -972,7 +1050,7 @@ public:
 		JS_DefineProperty( this->js, ( (flags & PROP_STATIC) ? JS_GetConstructor( this->js, classDef->proto) : classDef->proto ),
 						  propName, JSVAL_NULL, NULL, NULL, jflags);
 		GetterSetter gs( TypeArray, flags ); gs.Init( &getter );
-		classDef->getterSetter[ string(propName) ] = gs;
+		_SetGetterSetter( classDef, propName, gs );
 	}
 	
 /* MARK:	-				Property set
@@ -1001,6 +1079,37 @@ public:
 		JS_SetProperty( this->js, (JSObject*) obj, propName, &val );
 	}
 	
+	/// resolves native setter of numeric property on script object once, for repeated sets that bypass script ( e.g. tweens )
+	/// returned callback takes script object and value. Empty if obj has no native number property with this name.
+	ScriptFloatCallback GetNativeNumberSetter( const char *propName, void* obj ) {
+		if ( !obj ) return ScriptFloatCallback();
+		JSClass* jc = JS_GetClass( (JSObject*) obj );
+		if ( !( jc->flags & JSCLASS_HAS_PRIVATE ) || !JS_GetPrivate( (JSObject*) obj ) ) return ScriptFloatCallback();
+		ClassDef *cdef = CDEF( jc );
+		if ( !cdef ) return ScriptFloatCallback();
+		JSString* str = JS_InternString( this->js, propName );
+		GetterSetter* gs = FindGetterSetter( cdef, INTERNED_STRING_TO_JSID( this->js, str ) );
+		if ( !gs || ( gs->flags & PROP_READONLY ) ) return ScriptFloatCallback();
+		if ( gs->type == TypeFloat ) {
+			return [gs]( void* obj, float val ) {
+				void* self = JS_GetPrivate( (JSObject*) obj );
+				if ( !self ) return val;
+				val = gs->getterSetter[ 1 ].floatCallback( self, val );
+				NativePropertyChanged( self );
+				return val;
+			};
+		} else if ( gs->type == TypeInt ) {
+			return [gs]( void* obj, float val ) {
+				void* self = JS_GetPrivate( (JSObject*) obj );
+				if ( !self ) return val;
+				val = (float) gs->getterSetter[ 1 ].intCallback( self, (int32_t) val );
+				NativePropertyChanged( self );
+				return val;
+			};
+		}
+		return ScriptFloatCallback();
+	}
+	
 	/// prevent adding more properties
 	void FreezeObject( void *obj ) {
 		
@@ -1441,6 +1550,23 @@ public:
 	void GC() {
 		// call garbage collection in Spidermonkey
 		JS_GC( this->jsr );
+		this->gcBytesAfterCollection = JS_GetGCParameter( this->jsr, JSGC_BYTES );
+	}
+	
+	/// script heap size after last completed collection
+	uint32_t gcBytesAfterCollection = 0;
+	
+	/// collection is scheduled when heap grows by this factor since last collection
+	float gcGrowthFactor = 1.5f;
+	
+	/// ... and by at least this many bytes
+	uint32_t gcMinGrowth = 4 * 1024 * 1024;
+	
+	/// true if heap grew enough since last collection to start a new one
+	bool GCNeeded() {
+		uint32_t bytes = JS_GetGCParameter( this->jsr, JSGC_BYTES );
+		return bytes > this->gcBytesAfterCollection + this->gcMinGrowth &&
+			   bytes > (uint32_t) ( this->gcBytesAfterCollection * this->gcGrowthFactor );
 	}
 	
 	
@@ -5,6 +5,63 @@
 /// static event stack
 vector<Event*> Event::eventStack;
 
+/// interned event names, indexed by EventId
+static vector<const char*> *_eventNames = NULL;
+
+/// event name -> EventId
+static unordered_map<string, EventId> *_eventIds = NULL;
+
+/// registers built-in event names, so their ids match EVENTID_* constants
+static void _InitEventRegistry() {
+	static const char* builtInNames[] = {
+		"",
+		EVENT_SCENECHANGED, EVENT_UPDATE, EVENT_ADDED, EVENT_REMOVED, EVENT_CHILDADDED, EVENT_CHILDREMOVED,
+		EVENT_ADDEDTOSCENE, EVENT_REMOVEDFROMSCENE, EVENT_ACTIVECHANGED, EVENT_NAMECHANGED, EVENT_ATTACHED, EVENT_DETACHED,
+		EVENT_RENDER, EVENT_KEYDOWN, EVENT_KEYUP, EVENT_KEYPRESS, EVENT_MOUSEDOWN, EVENT_MOUSEUP, EVENT_MOUSEMOVE,
+		EVENT_MOUSEWHEEL, EVENT_CONTROLLERADDED, EVENT_CONTROLLERREMOVED, EVENT_JOYDOWN, EVENT_JOYUP, EVENT_JOYAXIS,
+		EVENT_JOYHAT, EVENT_MOUSEOVER, EVENT_MOUSEOUT, EVENT_CLICK, EVENT_MOUSEUPOUTSIDE, EVENT_FOCUSCHANGED,
+		EVENT_NAVIGATION, EVENT_TOUCH, EVENT_UNTOUCH, EVENT_FINISHED, EVENT_RESIZED, EVENT_AWAKE, EVENT_LAYOUT,
+		EVENT_ERROR, EVENT_LOG, EVENT_CHANGE, EVENT_DESTROYED
+	};
+	static_assert( sizeof( builtInNames ) / sizeof( const char* ) == EVENTID_BUILTIN_COUNT, "built-in event names must match EVENTID_* constants" );
+	_eventNames = new vector<const char*>();
+	_eventIds = new unordered_map<string, EventId>();
+	for ( EventId i = 0; i < EVENTID_BUILTIN_COUNT; i++ ) Event::IdForName( builtInNames[ i ] );
+}
+
+/// returns interned id for event name, new names are assigned an id on first use
+EventId Event::IdForName( const char* eventName ) {
+	if ( !_eventIds ) _InitEventRegistry();
+	// find existing
+	string key( eventName ? eventName : "" );
+	unordered_map<string, EventId>::iterator it = _eventIds->find( key );
+	if ( it != _eventIds->end() ) return it->second;
+	// add new - map keys don't move, so name pointer stays valid
+	EventId eventId = (EventId) _eventNames->size();
+	it = _eventIds->emplace( key, eventId ).first;
+	_eventNames->push_back( it->first.c_str() );
+	return eventId;
+}
+
+/// returns id for event name without interning it
+EventId Event::FindIdForName( const char* eventName ) {
+	if ( !_eventIds ) _InitEventRegistry();
+	unordered_map<string, EventId>::iterator it = _eventIds->find( string( eventName ? eventName : "" ) );
+	return it == _eventIds->end() ? EVENTID_NONE : it->second;
+}
+
+/// returns event name for interned id
+const char* Event::NameForId( EventId eventId ) {
+	if ( !_eventIds ) _InitEventRegistry();
+	return eventId < _eventNames->size() ? (*_eventNames)[ eventId ] : "";
+}
+
+/// number of interned event names
+size_t Event::NumNames() {
+	if ( !_eventIds ) _InitEventRegistry();
+	return _eventNames->size();
+}
+
 // destructor
 ScriptableClass::~ScriptableClass() {
 
@@ -161,7 +218,9 @@ void ScriptableClass::InitClass() {
 			}
 			
 			// listeners
-			EventListeners& list = self->eventListeners[ propName ];
+			EventId eventId = Event::IdForName( propName.c_str() );
+			EventListeners& list = self->eventListeners[ eventId ];
+			if ( handler ) self->EventHandlersChanged( eventId );
 			
 			// function specified
 			if ( handler ) {
@@ -234,7 +293,9 @@ void ScriptableClass::InitClass() {
 			}
 			
 			// remove from event listeners
-			EventListeners& list = self->eventListeners[ propName ];
+			EventId eventId = Event::IdForName( propName.c_str() );
+			EventListeners& list = self->eventListeners[ eventId ];
+			self->EventHandlersChanged( eventId );
 			EventListeners::iterator it = list.begin();
 			while ( it != list.end() ) {
 				ScriptFunctionObject& fo = *it;
@@ -377,30 +438,32 @@ void ScriptableClass::CallEvent( Event& event ) {
 	// ignore if finalizing
 	if ( script.IsAboutToBeFinalized( &this->scriptObject ) || event.stopped ) return;
 	
-	// event listeners array
-	EventListeners* list = &this->eventListeners[ event.name ];
-	
 	// some objects will dispatch events to functions with the same name, for ease of use
-	if ( this->dispatchEventsToPropertyFunctions ) {
-		// check if we have a callback with the same name as property
+	if ( this->dispatchEventsToPropertyFunctions && this->HasPropertyHandler( event.id ) ) {
+		// get callback with the same name as property
 		ArgValue funcObject = script.GetProperty( event.name, this->scriptObject );
 		if ( funcObject.type == TypeFunction ) {
 			// call function
 			script.CallFunction( funcObject.value.objectValue, this->scriptObject, event.scriptParams );
-            debugEventsDispatched[ string(event.name) ]++;
+            if ( app.debugDraw ) debugEventsDispatched[ event.name ]++;
 		}
 	}
 	
 	// if event was stopped, exit
 	if ( event.stopped ) return;
 	
+	// event listeners array
+	EventListenersMap::iterator lit = this->eventListeners.find( event.id );
+	if ( lit == this->eventListeners.end() ) return;
+	EventListeners* list = &lit->second;
+	
 	// call on all listeners - note that listeners may be removed while dispatching
 	EventListeners::iterator it = list->begin();
 	while ( it != list->end() ){
 		ScriptFunctionObject *fobj = &(*it);
 		fobj->thisObject = this->scriptObject;
 		fobj->Invoke( event.scriptParams );
-        debugEventsDispatched[ string(event.name) ]++;
+        if ( app.debugDraw ) debugEventsDispatched[ event.name ]++;
 		if ( fobj->callOnce ) {
 			it = list->erase( it );
 		} else it++;
@@ -20,6 +20,9 @@ struct Event {
 	/// event name
 	const char* name = "";
 	
+	/// interned event type id, matches name
+	EventId id = EVENTID_NONE;
+	
 	/// if true, it's dispatched in children first, then parent (GameObject uses this)
 	bool bubbles = false;
 	
@@ -60,12 +63,30 @@ struct Event {
 	    
 	static vector<Event*> eventStack;
 	
+	/// sets event name, and its interned id
+	void SetName( const char* eventName ) { this->id = Event::IdForName( eventName ); this->name = Event::NameForId( this->id ); }
+	
+	/// sets event id, and its name
+	void SetId( EventId eventId ) { this->id = eventId; this->name = Event::NameForId( eventId ); }
+	
+	/// returns interned id for event name, new names are assigned an id on first use
+	static EventId IdForName( const char* eventName );
+	
+	/// returns id for event name if it's already been interned, or EVENTID_NONE
+	static EventId FindIdForName( const char* eventName );
+	
+	/// returns event name for interned id
+	static const char* NameForId( EventId eventId );
+	
+	/// number of interned event names
+	static size_t NumNames();
+	
 	// constructor
 	Event(){ eventStack.push_back( this ); };
 	/// construct event with scriptObject as first script parameter
 	Event( void* scriptObject ) : Event::Event() { if ( scriptObject != NULL ) { this->scriptParams.ResizeArguments( 0 ); this->scriptParams.AddObjectArgument( scriptObject ); } }
 	/// construct named event with scriptObject as first script parameter, if provided
-	Event( const char* name, void* scriptObject=NULL ) : Event::Event( scriptObject ) { this->name =  name; }
+	Event( const char* name, void* scriptObject=NULL ) : Event::Event( scriptObject ) { this->SetName( name ); }
 	// destructor
 	~Event(){
 		if ( eventStack.back() == this ) {
@@ -106,9 +127,9 @@ public:
 // events
 	
 	typedef vector<ScriptFunctionObject> EventListeners;
-	typedef unordered_map<string, EventListeners> EventListenersMap;
+	typedef unordered_map<EventId, EventListeners> EventListenersMap;
 	
-	/// eventName -> vector of script function callbacks
+	/// event id -> vector of script function callbacks
 	EventListenersMap eventListeners;
 	
 	/// if true, also calls eventName() by name as function
@@ -117,19 +138,57 @@ public:
 	/// calls script event listeners on this ScriptableObject
 	virtual void CallEvent( Event& event );
 	
+	/// incremented when event handlers or object hierarchy change, new value is stamped on changed subtree's ancestors ( see GameObject::SubscriptionsChanged )
+	static uint32_t subscriptionsVersion;
+	
+	/// subscriptionsVersion when a change affecting every object happened ( event named property on a prototype ), invalidates all cached event subscriber lists
+	static uint32_t subscriptionsResetVersion;
+	
+	/// called when listeners or property functions for event change on this object ( EVENTID_NONE = any event )
+	virtual void EventHandlersChanged( EventId eventId ) {
+		if ( eventId == EVENTID_NONE ) this->propertyHandlers.clear();
+		else this->propertyHandlers.erase( eventId );
+		this->SubscriptionsChanged();
+	}
+	
+	/// invalidates cached event subscriber lists containing this object ( overridden in GameObject )
+	virtual void SubscriptionsChanged() {}
+	
+	/// called after a native property of this object was set from script
+	virtual void NativePropertyChanged() {}
+	
 	// true if .eventName, or "on" event listeners registered
-	bool HasListenersForEvent( const char* eventName ) {
-		EventListenersMap::iterator hit = this->eventListeners.find( string( eventName ) );
+	bool HasListenersForEvent( EventId eventId ) {
+		EventListenersMap::iterator hit = this->eventListeners.find( eventId );
 		bool hasHandler = ( hit != this->eventListeners.end() && hit->second.size() > 0 );
-		if ( !hasHandler && dispatchEventsToPropertyFunctions ) {
-			ArgValue hval = script.GetProperty( eventName, this->scriptObject );
-			if ( hval.type == TypeFunction ) {
-				return true;
-			}
-		}
+		if ( !hasHandler && dispatchEventsToPropertyFunctions ) return this->HasPropertyHandler( eventId );
 		return hasHandler;
 	}
 	
+	/// event id -> whether script object has a function property with event's name
+	unordered_map<EventId, bool> propertyHandlers;
+	
+	/// value of propertyHandlersVersion when propertyHandlers cache was filled
+	uint32_t propertyHandlersCacheVersion = 0;
+	
+	/// incremented when an event-named property changes on a prototype, invalidates all propertyHandlers caches
+	static uint32_t propertyHandlersVersion;
+	
+	/// true if script object has .eventName function, cached until property with that name is set or deleted
+	bool HasPropertyHandler( EventId eventId ) {
+		// prototype changed
+		if ( this->propertyHandlersCacheVersion != propertyHandlersVersion ) {
+			this->propertyHandlers.clear();
+			this->propertyHandlersCacheVersion = propertyHandlersVersion;
+		}
+		// cached
+		unordered_map<EventId, bool>::iterator it = this->propertyHandlers.find( eventId );
+		if ( it != this->propertyHandlers.end() ) return it->second;
+		// look up
+		ArgValue hval = script.GetProperty( Event::NameForId( eventId ), this->scriptObject );
+		return ( this->propertyHandlers[ eventId ] = ( hval.type == TypeFunction ) );
+	}
+	
 	// trace ops
 	
 	virtual void TraceProtectedObjects( vector<void**> &protectedObjects ) {
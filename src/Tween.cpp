@@ -75,8 +75,7 @@ Tween::Tween( ScriptArguments* args ) {
 Tween::~Tween() {
 	
 	// make sure to remove self from activeTweens
-	unordered_set<Tween*>::iterator it = activeTweens->find( this );
-	if ( it != activeTweens->end() ) activeTweens->erase( it );
+	this->_RemoveFromActive();
 	
 }
 
@@ -122,6 +121,12 @@ void Tween::InitClass() {
 	 static_cast<ScriptObjectCallback>([](void* go, void* p) {
 		Tween* self = (Tween*) go;
 		self->target = p;
+		self->_settersDirty = true;
+		// re-index running tween under new target
+		if ( self->_activeIndex >= 0 && self->_indexedTarget != p ) {
+			self->_UnindexTarget();
+			self->_IndexTarget();
+		}
 		return p;
 	}));
 	
@@ -258,12 +263,17 @@ void Tween::InitClass() {
 		void *obj = NULL;
 		args.ReadArguments( 1, TypeObject, &obj );
 		ArgValueVector vec;
-		unordered_set<Tween*>::iterator it = activeTweens->begin(), end = activeTweens->end();
-		while( it != end ) {
-			if ( !obj || (*it)->target == obj ) {
-				vec.emplace_back( (*it)->scriptObject );
+		if ( obj ) {
+			unordered_map<void*, vector<Tween*>>::iterator it = targetTweens->find( obj );
+			if ( it != targetTweens->end() ) {
+				for ( size_t i = 0, nt = it->second.size(); i < nt; i++ ) {
+					if ( it->second[ i ]->_active ) vec.emplace_back( it->second[ i ]->scriptObject );
+				}
+			}
+		} else {
+			for ( size_t i = 0, nt = activeTweens->size(); i < nt; i++ ) {
+				if ( (*activeTweens)[ i ]->_active ) vec.emplace_back( (*activeTweens)[ i ]->scriptObject );
 			}
-			it++;
 		}
 		args.ReturnArray( vec );
 		return true;
@@ -273,12 +283,12 @@ void Tween::InitClass() {
 		static_cast<ScriptFunctionCallback>([](void* p, ScriptArguments& args){
 		void *obj = NULL;
 		args.ReadArguments( 1, TypeObject, &obj );
-		unordered_set<Tween*>::iterator it = activeTweens->begin();
-		while( it != activeTweens->end() ) {
-			if ( !obj || (*it)->target == obj ) {
-				Tween* t = (*it);
-				t->active( false );
-			} else it++;
+		if ( obj ) {
+			StopTweens( obj );
+		} else {
+			for ( size_t i = 0, nt = activeTweens->size(); i < nt; i++ ) {
+				(*activeTweens)[ i ]->active( false );
+			}
 		}
 		return true;
 	}));
@@ -465,6 +475,7 @@ float Tween::Ease( Tween::EasingType type, Tween::EasingFunc func, float p ) {
 
 /// setter for property names
 void Tween::SetProperties( ArgValue val ) {
+	this->_settersDirty = true;
 	if ( val.type == TypeString ) {
 		// just one
 		properties.resize( 1 );
@@ -580,33 +591,77 @@ void Tween::active( bool r ) {
 		if ( r ) {
 			// restart if ended
 			if ( time >= duration ) time = 0;
-			activeTweens->insert( this );
+			this->_settersDirty = true;
+			// still listed if stopped and restarted within same frame
+			if ( this->_activeIndex < 0 ) this->_AddToActive();
 		}
 	}
 }
 
+/// appends to activeTweens and indexes by target
+void Tween::_AddToActive() {
+	this->_activeIndex = (int) activeTweens->size();
+	activeTweens->push_back( this );
+	this->_IndexTarget();
+}
+
+/// swap-removes from activeTweens and target index
+void Tween::_RemoveFromActive() {
+	if ( this->_activeIndex < 0 ) return;
+	Tween* last = activeTweens->back();
+	(*activeTweens)[ this->_activeIndex ] = last;
+	last->_activeIndex = this->_activeIndex;
+	activeTweens->pop_back();
+	this->_activeIndex = -1;
+	this->_UnindexTarget();
+}
+
+/// appends to target's list in targetTweens
+void Tween::_IndexTarget() {
+	vector<Tween*>& list = (*targetTweens)[ this->target ];
+	this->_indexedTarget = this->target;
+	this->_targetIndex = (int) list.size();
+	list.push_back( this );
+}
+
+/// swap-removes from target's list, removes list when empty
+void Tween::_UnindexTarget() {
+	if ( this->_targetIndex < 0 ) return;
+	unordered_map<void*, vector<Tween*>>::iterator it = targetTweens->find( this->_indexedTarget );
+	if ( it != targetTweens->end() ) {
+		vector<Tween*>& list = it->second;
+		Tween* last = list.back();
+		list[ this->_targetIndex ] = last;
+		last->_targetIndex = this->_targetIndex;
+		list.pop_back();
+		if ( list.empty() ) targetTweens->erase( it );
+	}
+	this->_targetIndex = -1;
+	this->_indexedTarget = NULL;
+}
+
 
 /* MARK:	-				Stop all
  -------------------------------------------------------------------- */
 
 
 void Tween::StopTweens( void* target, const char* prop ) {
-	unordered_set<Tween*>::iterator it = Tween::activeTweens->begin();
-	while( it != Tween::activeTweens->end() ) {
-		if ( (*it)->target == target ) {
-			Tween* t = *it;
-			bool remove = (prop == NULL);
-			if ( prop ) { // see if property matches
-				for ( size_t i = 0, np = t->properties.size(); i < np; i++ ){
-					if ( t->properties[ i ].compare( prop ) == 0 ) {
-						remove = true; break;
-					}
+	// only look at tweens running on target
+	unordered_map<void*, vector<Tween*>>::iterator it = Tween::targetTweens->find( target );
+	if ( it == Tween::targetTweens->end() ) return;
+	vector<Tween*>& list = it->second;
+	for ( size_t i = 0, nt = list.size(); i < nt; i++ ) {
+		Tween* t = list[ i ];
+		bool remove = (prop == NULL);
+		if ( prop ) { // see if property matches
+			for ( size_t j = 0, np = t->properties.size(); j < np; j++ ){
+				if ( t->properties[ j ].compare( prop ) == 0 ) {
+					remove = true; break;
 				}
 			}
-			if ( remove ) t->active( false );
 		}
-		it++;
-
+		// lists are only modified in ProcessActiveTweens, safe to keep iterating
+		if ( remove ) t->active( false );
 	}
 }
 
@@ -633,18 +688,27 @@ bool Tween::ProcessTween( float deltaTime, float unscaledDeltaTime ) {
 		this->callback.Invoke( callbackArguments );
 	}
 	
+	// look up native setters ( callback could have changed target or properties )
+	if ( this->_settersDirty ) this->ResolveSetters();
+	
 	// for each property
 	size_t np = this->properties.size();
 	size_t ns = startValues.size();
 	size_t ne = endValues.size();
+	float ease = Tween::Ease( easeType, easeFunc, pos );
 	for ( size_t i = 0; i < np; i++ ){
-		string& prop = this->properties[ i ];
 		float fromVal = ( i < ns ? startValues[ i ] : 0 );
 		float toVal = ( i < ne ? endValues[ i ] : 0 );
-		float value = fromVal + ( toVal - fromVal ) * Tween::Ease( easeType, easeFunc, pos );
+		float value = fromVal + ( toVal - fromVal ) * ease;
 		
 		// apply final value
-		script.SetProperty( prop.c_str(), ArgValue( value ), this->target );
+		if ( this->propertySetters[ i ] ) {
+			this->propertySetters[ i ]( this->target, value );
+		} else {
+			Tween::applyingValues = true;
+			script.SetProperty( this->properties[ i ].c_str(), ArgValue( value ), this->target );
+			Tween::applyingValues = false;
+		}
 	}
 	
 	// dispatch end event
@@ -666,21 +730,31 @@ bool Tween::ProcessTween( float deltaTime, float unscaledDeltaTime ) {
 	
 }
 
+/// resolves propertySetters for current target
+void Tween::ResolveSetters() {
+	size_t np = this->properties.size();
+	this->propertySetters.resize( np );
+	for ( size_t i = 0; i < np; i++ ) {
+		this->propertySetters[ i ] = script.GetNativeNumberSetter( this->properties[ i ].c_str(), this->target );
+	}
+	this->_settersDirty = false;
+}
+
 /// calls ProcessTween on all running tweens (called by game loop)
 void Tween::ProcessActiveTweens( float deltaTime, float unscaledDeltaTime ) {
-	// advance all active tweens
-	unordered_set<Tween*>::iterator it = activeTweens->begin();
-	while( it != activeTweens->end() ) {
-		if ( (*it)->_active && (*it)->ProcessTween( deltaTime, unscaledDeltaTime ) ) {
-			(*it)->_active = false;
+	// advance all active tweens ( tweens started during this loop are appended, and begin next frame; size can shrink if stopped tween is collected )
+	for ( size_t i = 0, nt = activeTweens->size(); i < nt && i < activeTweens->size(); i++ ) {
+		Tween* t = (*activeTweens)[ i ];
+		if ( t->_active && t->ProcessTween( deltaTime, unscaledDeltaTime ) ) {
+			t->_active = false;
 		}
-		it++;
 	}
-	// remove inactive
-	it = activeTweens->begin();
-	while( it != activeTweens->end() ) {
-		if ( !(*it)->_active ) {
-			it = activeTweens->erase( it );
-		} else it++;
+	// swap-remove inactive
+	size_t i = 0;
+	while( i < activeTweens->size() ) {
+		Tween* t = (*activeTweens)[ i ];
+		if ( !t->_active ) {
+			t->_RemoveFromActive();
+		} else i++;
 	}
 }
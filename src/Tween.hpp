@@ -36,12 +36,39 @@ public:
 		EaseBounce
 	};
 	
-	// all currently running tweens
-	static unordered_set<Tween*> *activeTweens;
+	// all currently running tweens ( dense, order isn't preserved; stopped tweens are removed in ProcessActiveTweens )
+	static vector<Tween*> *activeTweens;
+	
+	/// tweens in activeTweens, by target object
+	static unordered_map<void*, vector<Tween*>> *targetTweens;
+	
+	/// true while a tween is setting its properties, so the sets don't stop tweens
+	static bool applyingValues;
 	
 	/// iterate / increment currently running tweens
 	static void ProcessActiveTweens( float dt, float udt );
 	
+	/// index in activeTweens, or -1
+	int _activeIndex = -1;
+	
+	/// target this tween is listed under in targetTweens
+	void* _indexedTarget = NULL;
+	
+	/// index in targetTweens[ _indexedTarget ]
+	int _targetIndex = -1;
+	
+	/// adds to activeTweens and targetTweens
+	void _AddToActive();
+	
+	/// swap-removes from activeTweens and targetTweens
+	void _RemoveFromActive();
+	
+	/// adds to targetTweens under current target
+	void _IndexTarget();
+	
+	/// swap-removes from targetTweens
+	void _UnindexTarget();
+	
 	/// step tween - return true, if should be removed from active
 	bool ProcessTween( float dt, float udt );
 	
@@ -64,6 +91,15 @@ public:
 	void SetProperties( ArgValue val );
 	ArgValue GetProperties();
 	
+	/// native setters for properties, resolved when tween starts ( empty = set through script )
+	vector<ScriptFloatCallback> propertySetters;
+	
+	/// true when propertySetters need to be resolved again ( target or properties changed )
+	bool _settersDirty = true;
+	
+	/// resolves propertySetters for current target
+	void ResolveSetters();
+	
 	/// custom update function
 	ScriptFunctionObject callback;
 	
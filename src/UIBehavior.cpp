@@ -906,9 +906,8 @@ bool UIBehavior::Focus() {
 	
 	// if focus changed during a navigation event, cancel it
 	vector<Event*>::iterator e = Event::eventStack.begin();
-	string navEvent(EVENT_NAVIGATION);
 	while( e != Event::eventStack.end() ) {
-		if ( navEvent.compare( (*e)->name ) == 0 ) {
+		if ( (*e)->id == EVENTID_NAVIGATION ) {
 			(*e)->stopped = true;
 			break;
 		}
@@ -1124,7 +1123,7 @@ void UIBehavior::Layout( UIBehavior *behavior, void *p, Event *event ){
 	// check if gameObject is current scene
 	if ( behavior->gameObject == event->scene ) {
 		// if ui has no layout handler (automatic behavior)
-		if ( !behavior->HasListenersForEvent( EVENT_LAYOUT ) ) {
+		if ( !behavior->HasListenersForEvent( EVENTID_LAYOUT ) ) {
 			// apply anchor layout using screen size
 			float x, y;
 			behavior->GetAnchoredPosition( NULL, x, y, behavior->layoutWidth, behavior->layoutHeight );
@@ -1166,7 +1165,7 @@ void UIBehavior::Layout( UIBehavior *behavior, void *p, Event *event ){
 	// if there's render component
 	/* if ( behavior->gameObject->render ) {
 		// determine if there's no layout handler
-		EventListenersMap::iterator hit = behavior->eventListeners.find( string( EVENT_LAYOUT ) );
+		EventListenersMap::iterator hit = behavior->eventListeners.find( EVENTID_LAYOUT );
 		bool hasHandler = ( hit != behavior->eventListeners.end() && hit->second.size() > 0 );
 		if ( !hasHandler ) {
 			ArgValue hval = script.GetProperty( EVENT_LAYOUT, behavior->scriptObject );
@@ -1814,6 +1813,7 @@ void UIBehavior::DebugDraw( GPU_Target* targ ) {
 		boundsMinMax = { 255, 128, 128, 64 },
 		padding = { 255, 255, 128, 64 },
 		margins = { 128, 128, 200, 64 };
+	RenderBehavior::FlushSpriteBatch();
 	GPU_DeactivateShaderProgram();//GPU_ActivateShaderProgram( 0, NULL );
 	GPU_SetShapeBlendMode( GPU_BLEND_NORMAL );
 	GPU_SetLineThickness( 1 );
@@ -1952,7 +1952,7 @@ void UIBehavior::MouseButton( UIBehavior* behavior, void* param, Event* e){
 	int btn = e->scriptParams.args[ 0 ].value.intValue;
 	float localX = 0, localY = 0;
 	bool inBounds = behavior->IsScreenPointInBounds( x, y, &localX, &localY );
-	bool down = ( strcmp( e->name, EVENT_MOUSEDOWN ) == 0 );
+	bool down = ( e->id == EVENTID_MOUSEDOWN );
 	
 	// if clipped by RenderSprite/image+autoDraw, check if still in bounds
 	if ( inBounds && e->clippedBy ) {
@@ -1986,7 +1986,8 @@ void UIBehavior::MouseButton( UIBehavior* behavior, void* param, Event* e){
 		e->isUIEventInBounds = true;
 		
 		// dispatch mousedown or mouseup
-		Event event( e->name );
+		Event event;
+		event.SetId( e->id );
 		event.scriptParams.AddIntArgument( btn );
 		event.scriptParams.AddFloatArgument( localX );
 		event.scriptParams.AddFloatArgument( localY );
@@ -1996,7 +1997,7 @@ void UIBehavior::MouseButton( UIBehavior* behavior, void* param, Event* e){
 		
 		// mouse button was released
 		if ( wasDown && !down ){
-			event.name = EVENT_CLICK;
+			event.SetId( EVENTID_CLICK );
 			behavior->CallEvent( event );
 		}
 		
@@ -2135,7 +2136,7 @@ void UIBehavior::Detached( UIBehavior* behavior, GameObject* go, Event* e ){
 	UIBehavior::rollovers.erase( behavior );
 	
 	// if old parent had UI
-	if ( strcmp( e->name, EVENT_REMOVED ) == 0 && go && go->ui ){
+	if ( e->id == EVENTID_REMOVED && go && go->ui ){
 		go->ui->RequestLayout( ArgValue( e->name ) );
 	}
 	
@@ -1,3 +1,6 @@
+#ifndef common_h
+#define common_h
+
 // system includes and STL
 #include <stdio.h>
 #include <sys/stat.h>
@@ -14,6 +17,7 @@
 #include <algorithm>
 #include <math.h>
 #include <functional>
+#include <memory>
 using namespace std;
 
 // SDL
@@ -54,8 +58,6 @@ using namespace JS;
 
 // global funcs (defined at the end of Application.cpp)
 size_t HashString( const char* p );
-float* MatrixCompose( float* mat, float x, float y, float angleDegrees, float scaleX, float scaleY );
-void MatrixSkew( float* result, float sx, float sy );
 string ResolvePath( const char* filepath, const char* ext, const char* optionalSubPath );
 string ResolvePath( const char* filepath, const char* commaSeparatedExtensions, string& extension, const char* optionalSubPath );
 const char* ReadFile( const char* filepath, const char* ext, const char* optionalSubPath, string* finalPath, size_t *fileSize );
@@ -70,6 +72,7 @@ int StringPositionLength( const char* str );
 string base64_encode( unsigned char const*, unsigned int len );
 string base64_decode( string const& s );
 string GetScriptNameAndLine();
+const char* GetCallingScriptFilename();
 string ExecCommand( const char* cmd );
 
 // built in resources - added using http://www.fourmilab.ch/xd/
@@ -81,6 +84,9 @@ extern int RobotoBold_size;
 extern unsigned char ParticleTexture[];
 extern int ParticleTexture_size;
 
+/// interned event type id (see Event::IdForName)
+typedef uint32_t EventId;
+
 // debug
 extern size_t debugObjectsCreated;
 extern size_t debugObjectsDestroyed;
@@ -149,6 +155,55 @@ extern unordered_map<string,size_t> debugEventsDispatched;
 #define EVENT_CHANGE "change"
 #define EVENT_DESTROYED "destroyed"
 
+/// ids of built-in event types, in the same order as names registered in ScriptableClass.cpp
+/// events defined in script are assigned ids starting at EVENTID_BUILTIN_COUNT on first use
+enum {
+	EVENTID_NONE = 0,
+	EVENTID_SCENECHANGED,
+	EVENTID_UPDATE,
+	EVENTID_ADDED,
+	EVENTID_REMOVED,
+	EVENTID_CHILDADDED,
+	EVENTID_CHILDREMOVED,
+	EVENTID_ADDEDTOSCENE,
+	EVENTID_REMOVEDFROMSCENE,
+	EVENTID_ACTIVECHANGED,
+	EVENTID_NAMECHANGED,
+	EVENTID_ATTACHED,
+	EVENTID_DETACHED,
+	EVENTID_RENDER,
+	EVENTID_KEYDOWN,
+	EVENTID_KEYUP,
+	EVENTID_KEYPRESS,
+	EVENTID_MOUSEDOWN,
+	EVENTID_MOUSEUP,
+	EVENTID_MOUSEMOVE,
+	EVENTID_MOUSEWHEEL,
+	EVENTID_CONTROLLERADDED,
+	EVENTID_CONTROLLERREMOVED,
+	EVENTID_JOYDOWN,
+	EVENTID_JOYUP,
+	EVENTID_JOYAXIS,
+	EVENTID_JOYHAT,
+	EVENTID_MOUSEOVER,
+	EVENTID_MOUSEOUT,
+	EVENTID_CLICK,
+	EVENTID_MOUSEUPOUTSIDE,
+	EVENTID_FOCUSCHANGED,
+	EVENTID_NAVIGATION,
+	EVENTID_TOUCH,
+	EVENTID_UNTOUCH,
+	EVENTID_FINISHED,
+	EVENTID_RESIZED,
+	EVENTID_AWAKE,
+	EVENTID_LAYOUT,
+	EVENTID_ERROR,
+	EVENTID_LOG,
+	EVENTID_CHANGE,
+	EVENTID_DESTROYED,
+	EVENTID_BUILTIN_COUNT
+};
+
 // additional blending mode
 #define GPU_BLEND_CUT_ALPHA 16
 
@@ -160,3 +215,5 @@ class Application;
 // global variables
 extern ScriptHost script;
 extern Application app;
+
+#endif /* common_h */